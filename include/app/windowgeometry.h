@@ -25,6 +25,7 @@
 
 #include <boost/json.hpp>
 #include "helpers/ijsonserializable.h"
+#include "helpers/jsonfields.h"
 
 namespace Nickvision::App
 {
@@ -60,7 +61,7 @@ namespace Nickvision::App
          * @brief Constructs a WindowGeometry.
          * @param json The json object
          */
-        WindowGeometry(boost::json::object json) noexcept;
+        WindowGeometry(const boost::json::object& json) noexcept;
         /**
          * @brief Gets the width of the window.
          * @return The width of the window 
@@ -116,10 +117,27 @@ namespace Nickvision::App
          * @return The Json representation of the object
          */
         boost::json::value toJson() const noexcept override;
+        /**
+         * @brief Serializes the object to a Json string.
+         * @return The Json string representation of the object
+         */
+        std::string toJsonString() const noexcept override;
         WindowGeometry& operator=(const WindowGeometry&) noexcept = default;
         WindowGeometry& operator=(WindowGeometry&&) noexcept = default;
 
     private:
+        /**
+         * @brief Gets the descriptors of the fields serialized to Json.
+         * @return The descriptors of the fields
+         */
+        static constexpr auto getJsonFields() noexcept
+        {
+            return std::make_tuple(Helpers::JsonField{ "Width", &WindowGeometry::m_width },
+                Helpers::JsonField{ "Height", &WindowGeometry::m_height },
+                Helpers::JsonField{ "IsMaximized", &WindowGeometry::m_isMaximized },
+                Helpers::JsonField{ "X", &WindowGeometry::m_x },
+                Helpers::JsonField{ "Y", &WindowGeometry::m_y });
+        }
         long m_width;
         long m_height;
         bool m_isMaximized;
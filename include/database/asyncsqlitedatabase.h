@@ -0,0 +1,207 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A sqlite (sqlcipher) database that runs its commands on a dedicated thread.
+ */
+
+#ifndef ASYNCSQLITEDATABASE_H
+#define ASYNCSQLITEDATABASE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "helpers/cancellationtoken.h"
+#include "sqlitedatabase.h"
+
+namespace Nickvision::Database
+{
+    /**
+     * @brief A sqlite (sqlcipher) database that runs its commands on a dedicated thread.
+     * @brief Tasks are queued and run in order on the database's thread with exclusive access to its connection, and their results are returned through futures.
+     * @brief Consecutive queued write tasks are batched into a single transaction, each within its own savepoint, so a task that throws does not affect the others.
+     * @brief A write task with a cancellation token runs in a transaction of its own, as interrupting a command rolls back the whole transaction.
+     * @brief Tasks still queued when the database is destroyed are run before it is closed.
+     */
+    class AsyncSqliteDatabase
+    {
+    public:
+        /**
+         * @brief Constructs an AsyncSqliteDatabase.
+         * @brief If the database is not encrypted, it will be unlocked automatically.
+         * @param path The path to the database file
+         * @param flags The flags for opening the database
+         * @throw std::runtime_error Thrown if the database cannot be opened
+         */
+        AsyncSqliteDatabase(const std::filesystem::path& path, int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+        AsyncSqliteDatabase(const AsyncSqliteDatabase&) = delete;
+        AsyncSqliteDatabase(AsyncSqliteDatabase&&) = delete;
+        /**
+         * @brief Destructs an AsyncSqliteDatabase, waiting for all queued tasks to finish.
+         */
+        ~AsyncSqliteDatabase() noexcept;
+        /**
+         * @brief Gets the path of the database file.
+         * @return The database file path
+         */
+        const std::filesystem::path& getPath() const noexcept;
+        /**
+         * @brief Queues a task that reads from the database.
+         * @brief If the token is cancelled, the task's running sql commands are interrupted and the future throws std::runtime_error.
+         * @tparam Function The type of the task, callable as Result(SqliteDatabase&)
+         * @param task The task to run on the database's thread
+         * @param token An optional token to cancel the task
+         * @return The future result of the task, which rethrows any exception thrown by the task
+         */
+        template<typename Function>
+        std::future<std::invoke_result_t<Function&, SqliteDatabase&>> read(Function&& task, const std::shared_ptr<Helpers::CancellationToken>& token = nullptr)
+        {
+            return enqueue(false, std::forward<Function>(task), token);
+        }
+        /**
+         * @brief Queues a task that writes to the database.
+         * @brief The task runs within a transaction and must not begin a SqliteTransaction itself. Use SqliteSavepoint to nest changes instead.
+         * @brief Without a token, the transaction is shared with other queued writes. If the task throws, only its changes are rolled back. The future is only resolved once the transaction has been committed.
+         * @brief With a token, the task runs in its own transaction. If the token is cancelled, the task's running sql commands are interrupted, its changes are rolled back and the future throws std::runtime_error.
+         * @tparam Function The type of the task, callable as Result(SqliteDatabase&)
+         * @param task The task to run on the database's thread
+         * @param token An optional token to cancel the task
+         * @return The future result of the task, which rethrows any exception thrown by the task
+         */
+        template<typename Function>
+        std::future<std::invoke_result_t<Function&, SqliteDatabase&>> write(Function&& task, const std::shared_ptr<Helpers::CancellationToken>& token = nullptr)
+        {
+            return enqueue(true, std::forward<Function>(task), token);
+        }
+        /**
+         * @brief Queues a sql command that writes to the database.
+         * @param command The command to execute
+         * @return The future result of SqliteDatabase::execute()
+         */
+        std::future<bool> execute(const std::string& command);
+        AsyncSqliteDatabase& operator=(const AsyncSqliteDatabase&) = delete;
+        AsyncSqliteDatabase& operator=(AsyncSqliteDatabase&&) = delete;
+
+    private:
+        /**
+         * @brief A queued task.
+         */
+        struct Task
+        {
+            bool isWrite;
+            std::shared_ptr<Helpers::CancellationToken> token;
+            std::function<void(SqliteDatabase&)> run;
+            std::function<void()> complete;
+            std::function<void(std::exception_ptr)> fail;
+        };
+        /**
+         * @brief Queues a task.
+         * @tparam Function The type of the task, callable as Result(SqliteDatabase&)
+         * @param isWrite Whether or not the task writes to the database
+         * @param function The task to run on the database's thread
+         * @param token An optional token to cancel the task
+         * @return The future result of the task
+         */
+        template<typename Function>
+        std::future<std::invoke_result_t<Function&, SqliteDatabase&>> enqueue(bool isWrite, Function&& function, const std::shared_ptr<Helpers::CancellationToken>& token)
+        {
+            using Result = std::invoke_result_t<Function&, SqliteDatabase&>;
+            static_assert(!std::is_reference_v<Result>, "Tasks must return a value, not a reference.");
+            //Shared, so move-only tasks can be stored in a std::function
+            std::shared_ptr<std::decay_t<Function>> func{ std::make_shared<std::decay_t<Function>>(std::forward<Function>(function)) };
+            std::shared_ptr<std::promise<Result>> promise{ std::make_shared<std::promise<Result>>() };
+            std::future<Result> future{ promise->get_future() };
+            Task task{ isWrite, token, {}, {}, [promise](std::exception_ptr e)
+            {
+                promise->set_exception(e);
+            } };
+            if constexpr (std::is_void_v<Result>)
+            {
+                task.run = [func](SqliteDatabase& database)
+                {
+                    (*func)(database);
+                };
+                task.complete = [promise]()
+                {
+                    promise->set_value();
+                };
+            }
+            else
+            {
+                std::shared_ptr<std::optional<Result>> result{ std::make_shared<std::optional<Result>>() };
+                task.run = [func, result](SqliteDatabase& database)
+                {
+                    result->emplace((*func)(database));
+                };
+                task.complete = [promise, result]()
+                {
+                    promise->set_value(std::move(**result));
+                };
+            }
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_tasks.push_back(std::move(task));
+            }
+            m_condition.notify_one();
+            return future;
+        }
+        /**
+         * @brief Runs queued tasks until the database is destroyed and the queue is empty.
+         */
+        void runQueue() noexcept;
+        /**
+         * @brief Runs a task, without completing it.
+         * @param task The task to run
+         * @return True if the task succeeded, else false if it was cancelled or threw (in which case it has been failed)
+         */
+        bool runTask(Task& task) noexcept;
+        /**
+         * @brief Removes the cancel function of a task's token, waiting for it to finish if it is running.
+         * @param task The task (which must have a token)
+         */
+        void disarmTask(Task& task) noexcept;
+        /**
+         * @brief Runs a batch of write tasks within a single transaction, completing them once it is committed.
+         * @param tasks The write tasks to run
+         */
+        void runWrites(std::vector<Task>& tasks) noexcept;
+        SqliteDatabase m_database;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<Task> m_tasks;
+        bool m_stopping;
+        std::mutex m_interruptMutex;
+        std::uint64_t m_lastTaskId;
+        std::uint64_t m_interruptibleTaskId;
+        std::thread m_thread;
+    };
+}
+
+#endif //ASYNCSQLITEDATABASE_H
@@ -27,9 +27,14 @@
 #define SQLITE_HAS_CODEC
 #endif
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 #ifdef _WIN32
 #include <sqlcipher/sqlite3.h>
 #else
@@ -38,12 +43,61 @@
 
 namespace Nickvision::Database
 {
+    /**
+     * @brief An owned sqlite BLOB.
+     */
+    using SqliteBlob = std::vector<std::byte>;
+    /**
+     * @brief A non-owning view of a sqlite BLOB.
+     */
+    using SqliteBlobView = std::span<const std::byte>;
+
     template<typename T>
     concept SupportedSqliteValue = std::is_same_v<T, int> || 
         std::is_same_v<T, std::int64_t> || 
         std::is_same_v<T, double> || 
         std::is_same_v<T, bool> || 
-        std::is_same_v<T, std::string>;
+        std::is_same_v<T, std::string> ||
+        std::is_same_v<T, std::string_view> ||
+        std::is_same_v<T, SqliteBlob> ||
+        std::is_same_v<T, SqliteBlobView>;
+
+    template<typename T>
+    concept SqliteViewValue = std::is_same_v<T, std::string_view> || std::is_same_v<T, SqliteBlobView>;
+
+    /**
+     * @brief Gets the tuple of column types of a sqlite row type.
+     * @brief A std::tuple of SupportedSqliteValues is its own column types. Any other row type declares its column types with a nested SqliteColumns tuple, in the order of its constructor parameters or aggregate members.
+     */
+    template<typename Row>
+    struct SqliteRowTraits
+    {
+        using Columns = typename Row::SqliteColumns;
+    };
+
+    template<typename... Ts>
+    struct SqliteRowTraits<std::tuple<Ts...>>
+    {
+        using Columns = std::tuple<Ts...>;
+    };
+
+    template<typename Columns>
+    struct SqliteColumnsTraits : std::false_type
+    {
+        static constexpr bool hasViews{ false };
+    };
+
+    template<typename... Ts>
+    struct SqliteColumnsTraits<std::tuple<Ts...>> : std::bool_constant<(SupportedSqliteValue<Ts> && ...)>
+    {
+        static constexpr bool hasViews{ (SqliteViewValue<Ts> || ...) };
+    };
+
+    template<typename T>
+    concept SqliteRow = requires { typename SqliteRowTraits<T>::Columns; } && SqliteColumnsTraits<typename SqliteRowTraits<T>::Columns>::value;
+
+    template<typename T>
+    concept SqliteOwningRow = SqliteRow<T> && !SqliteColumnsTraits<typename SqliteRowTraits<T>::Columns>::hasViews;
 }
 
 #endif //SQLITE_H
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * The callbacks of a custom sqlite aggregate or window function.
+ */
+
+#ifndef SQLITEAGGREGATEFUNCTION_H
+#define SQLITEAGGREGATEFUNCTION_H
+
+#include <functional>
+#include "sqlitefunctioncontext.h"
+
+namespace Nickvision::Database
+{
+    using SqliteCustomFunction = std::function<void(SqliteFunctionContext&)>;
+
+    /**
+     * @brief The callbacks of a custom sqlite aggregate or window function.
+     * @brief The callbacks share the state of the current group through SqliteFunctionContext::getState().
+     */
+    struct SqliteAggregateFunction
+    {
+        /**
+         * @brief Adds a row to the current group. 
+         */
+        SqliteCustomFunction step{};
+        /**
+         * @brief Returns the result of the current group, after which its state is destroyed.
+         */
+        SqliteCustomFunction final{};
+        /**
+         * @brief Returns the current result of a window without ending it (optional, required for window functions).
+         */
+        SqliteCustomFunction value{};
+        /**
+         * @brief Removes the oldest row from the current window (optional, required for window functions).
+         */
+        SqliteCustomFunction inverse{};
+    };
+}
+
+#endif //SQLITEAGGREGATEFUNCTION_H
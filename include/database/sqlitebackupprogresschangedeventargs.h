@@ -0,0 +1,64 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * An event argument for when the progress of a sqlite backup has changed.
+ */
+
+#ifndef SQLITEBACKUPPROGRESSCHANGEDEVENTARGS_H
+#define SQLITEBACKUPPROGRESSCHANGEDEVENTARGS_H
+
+#include "events/eventargs.h"
+
+namespace Nickvision::Database
+{
+    /**
+     * @brief An event argument for when the progress of a sqlite backup has changed.
+     */
+    class SqliteBackupProgressChangedEventArgs : public Events::EventArgs
+    {
+    public:
+        /**
+         * @brief Constructs a SqliteBackupProgressChangedEventArgs.
+         * @param remainingPages The number of pages left to copy
+         * @param totalPages The total number of pages of the database
+         */
+        SqliteBackupProgressChangedEventArgs(int remainingPages, int totalPages) noexcept;
+        /**
+         * @brief Gets the number of pages left to copy.
+         * @return The number of remaining pages
+         */
+        int getRemainingPages() const noexcept;
+        /**
+         * @brief Gets the total number of pages of the database.
+         * @return The number of total pages
+         */
+        int getTotalPages() const noexcept;
+        /**
+         * @brief Gets the progress of the backup.
+         * @return The progress (between 0.0 and 1.0)
+         */
+        double getProgress() const noexcept;
+
+    private:
+        int m_remainingPages;
+        int m_totalPages;
+    };
+}
+
+#endif //SQLITEBACKUPPROGRESSCHANGEDEVENTARGS_H
@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A connection leased from a SqliteConnectionPool.
+ */
+
+#ifndef SQLITECONNECTION_H
+#define SQLITECONNECTION_H
+
+#include <cstddef>
+#include "sqlitedatabase.h"
+
+namespace Nickvision::Database
+{
+    class SqliteConnectionPool;
+
+    /**
+     * @brief A connection leased from a SqliteConnectionPool.
+     * @brief The connection is returned to the pool when destroyed. The pool must outlive its connections.
+     */
+    class SqliteConnection
+    {
+    public:
+        SqliteConnection(const SqliteConnection&) = delete;
+        /**
+         * @brief Constructs a SqliteConnection via move.
+         * @param other The SqliteConnection to move
+         */
+        SqliteConnection(SqliteConnection&& other) noexcept;
+        /**
+         * @brief Destructs a SqliteConnection, returning it to its pool.
+         */
+        ~SqliteConnection() noexcept;
+        /**
+         * @brief Gets whether or not the connection is read-only.
+         * @return True if read-only, else false
+         */
+        bool isReadOnly() const noexcept;
+        SqliteConnection& operator=(const SqliteConnection&) = delete;
+        /**
+         * @brief Assigns a SqliteConnection via move.
+         * @param other The SqliteConnection to move
+         * @return Reference to this SqliteConnection
+         */
+        SqliteConnection& operator=(SqliteConnection&& other) noexcept;
+        /**
+         * @brief Gets the database of the connection.
+         * @return The database
+         */
+        SqliteDatabase& operator*() const noexcept;
+        /**
+         * @brief Gets the database of the connection.
+         * @return The database
+         */
+        SqliteDatabase* operator->() const noexcept;
+        /**
+         * @brief Gets whether or not the object is valid or not.
+         * @return True if valid, else false
+         */
+        operator bool() const noexcept;
+
+    private:
+        friend class SqliteConnectionPool;
+        /**
+         * @brief Constructs a SqliteConnection.
+         * @param pool The pool the connection belongs to
+         * @param index The index of the connection in the pool
+         * @param database The database of the connection
+         */
+        SqliteConnection(SqliteConnectionPool* pool, size_t index, SqliteDatabase* database) noexcept;
+        /**
+         * @brief Returns the connection to its pool.
+         */
+        void release() noexcept;
+        SqliteConnectionPool* m_pool;
+        size_t m_index;
+        SqliteDatabase* m_database;
+    };
+}
+
+#endif //SQLITECONNECTION_H
@@ -0,0 +1,195 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A pool of connections to a sqlite (sqlcipher) database.
+ */
+
+#ifndef SQLITECONNECTIONPOOL_H
+#define SQLITECONNECTIONPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "sqliteconnection.h"
+#include "sqlitedatabase.h"
+
+namespace Nickvision::Database
+{
+    /**
+     * @brief Levels of sqlite's synchronous pragma.
+     */
+    enum class SqliteSynchronous
+    {
+        Off = 0, ///< Data is handed to the operating system without syncing
+        Normal = 1, ///< In WAL mode, commits are durable once the WAL is checkpointed
+        Full = 2, ///< Every commit is synced to the storage device
+        Extra = 3 ///< Like Full, also syncing the directory of the journal
+    };
+
+    /**
+     * @brief A pool of connections to a sqlite (sqlcipher) database.
+     * @brief The pool holds one writer connection and a number of read-only connections, with the database in WAL mode so readers never block the writer or each other.
+     * @brief Connections are handed out to one thread at a time and returned when the SqliteConnection is destroyed.
+     * @brief Pragmas and custom functions are applied to every connection before it is next handed out.
+     */
+    class SqliteConnectionPool
+    {
+    public:
+        /**
+         * @brief Constructs a SqliteConnectionPool.
+         * @brief If the database is not encrypted, it will be unlocked automatically.
+         * @param path The path to the database file
+         * @param readers The number of read-only connections
+         * @throw std::invalid_argument Thrown if readers is 0
+         * @throw std::runtime_error Thrown if a connection cannot be opened
+         */
+        SqliteConnectionPool(const std::filesystem::path& path, size_t readers = 4);
+        SqliteConnectionPool(const SqliteConnectionPool&) = delete;
+        SqliteConnectionPool(SqliteConnectionPool&&) = delete;
+        /**
+         * @brief Gets the path of the database file.
+         * @return The database file path
+         */
+        const std::filesystem::path& getPath() const noexcept;
+        /**
+         * @brief Gets the number of read-only connections.
+         * @return The number of read-only connections
+         */
+        size_t getReaderCount() const noexcept;
+        /**
+         * @brief Gets whether or not the database is encrypted.
+         * @return True if encrypted, else false
+         */
+        bool isEncrypted() const noexcept;
+        /**
+         * @brief Gets whether or not the database is unlocked.
+         * @return True if unlocked, else false
+         */
+        bool isUnlocked() const noexcept;
+        /**
+         * @brief Unlocks every connection of the database.
+         * @brief If the database is not encrypted, this method will have no effect and return true.
+         * @param password The password of the database
+         * @return True if unlocked, else false
+         */
+        bool unlock(const std::string& password) noexcept;
+        /**
+         * @brief Gets the synchronous level of the connections.
+         * @return The synchronous level
+         */
+        SqliteSynchronous getSynchronous() const noexcept;
+        /**
+         * @brief Sets the synchronous level of the connections.
+         * @param synchronous The synchronous level
+         */
+        void setSynchronous(SqliteSynchronous synchronous) noexcept;
+        /**
+         * @brief Gets the maximum number of bytes of the database file each connection memory maps.
+         * @return The mmap size in bytes
+         */
+        std::int64_t getMmapSize() const noexcept;
+        /**
+         * @brief Sets the maximum number of bytes of the database file each connection memory maps.
+         * @param size The mmap size in bytes (0 to disable memory mapping)
+         */
+        void setMmapSize(std::int64_t size) noexcept;
+        /**
+         * @brief Gets the size of the page cache of each connection.
+         * @return The cache size in KiB
+         */
+        std::int64_t getCacheSize() const noexcept;
+        /**
+         * @brief Sets the size of the page cache of each connection.
+         * @param size The cache size in KiB
+         */
+        void setCacheSize(std::int64_t size) noexcept;
+        /**
+         * @brief Registers a custom sql function to every connection of the database.
+         * @brief The function is registered to each connection before it is next handed out. If that fails, it is retried the next time the connection is handed out.
+         * @param name The name of the sql function
+         * @param func The custom sql function
+         * @param expectedArgs The number of args the sql function expects to receive (specify -1 for unlimited number of args)
+         * @param flags The behavior of the sql function
+         * @return True if the function was added to the pool, else false (including if func is empty)
+         */
+        bool registerFunction(const std::string& name, const SqliteCustomFunction& func, int expectedArgs = -1, SqliteFunctionFlags flags = SqliteFunctionFlags::None) noexcept;
+        /**
+         * @brief Registers a custom sql aggregate function to every connection of the database.
+         * @brief The function is registered to each connection before it is next handed out. If that fails, it is retried the next time the connection is handed out.
+         * @param name The name of the sql function
+         * @param func The callbacks of the sql function
+         * @param expectedArgs The number of args the sql function expects to receive (specify -1 for unlimited number of args)
+         * @param flags The behavior of the sql function
+         * @return True if the function was added to the pool, else false (including if step or final is missing, or only one of value and inverse is set)
+         */
+        bool registerAggregateFunction(const std::string& name, const SqliteAggregateFunction& func, int expectedArgs = -1, SqliteFunctionFlags flags = SqliteFunctionFlags::None) noexcept;
+        /**
+         * @brief Gets a read-only connection, waiting until one is available.
+         * @return The read-only connection
+         */
+        SqliteConnection getReader() noexcept;
+        /**
+         * @brief Gets the writer connection, waiting until it is available.
+         * @return The writer connection
+         */
+        SqliteConnection getWriter() noexcept;
+        SqliteConnectionPool& operator=(const SqliteConnectionPool&) = delete;
+        SqliteConnectionPool& operator=(SqliteConnectionPool&&) = delete;
+
+    private:
+        friend class SqliteConnection;
+        /**
+         * @brief Gets the first available connection in a range, waiting until one is available.
+         * @param first The index of the first connection of the range
+         * @param last The index past the last connection of the range
+         * @return The connection
+         */
+        SqliteConnection acquire(size_t first, size_t last) noexcept;
+        /**
+         * @brief Returns a connection to the pool.
+         * @param index The index of the connection
+         */
+        void release(size_t index) noexcept;
+        /**
+         * @brief Applies the pragmas and custom functions that changed since a connection was last configured.
+         * @brief Pragmas and functions that fail to apply are applied again the next time the connection is configured.
+         * @param index The index of the connection, which must be leased by the caller
+         */
+        void configure(size_t index) noexcept;
+        std::filesystem::path m_path;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_released;
+        std::vector<SqliteDatabase> m_connections;
+        std::vector<bool> m_inUse;
+        std::vector<std::uint64_t> m_configuredVersions;
+        std::vector<size_t> m_registeredFunctions;
+        std::vector<std::function<bool(SqliteDatabase&)>> m_functions;
+        std::uint64_t m_settingsVersion;
+        SqliteSynchronous m_synchronous;
+        std::int64_t m_mmapSize;
+        std::int64_t m_cacheSize;
+    };
+}
+
+#endif //SQLITECONNECTIONPOOL_H
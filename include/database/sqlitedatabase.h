@@ -31,18 +31,29 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <ranges>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include "sqlite.h"
+#include "sqliteaggregatefunction.h"
+#include "sqlitebackupprogresschangedeventargs.h"
 #include "sqlitefunctioncontext.h"
+#include "sqlitefunctionflags.h"
+#include "sqlitesavepoint.h"
 #include "sqlitestatement.h"
+#include "sqlitestatementcache.h"
+#include "sqlitetransaction.h"
+#include "events/event.h"
+#include "helpers/cancellationtoken.h"
 
 namespace Nickvision::Database
 {
-    using SqliteCustomFunction = std::function<void(SqliteFunctionContext&)>;
-
     /**
      * @brief A thread-safe sqlite (sqlcipher) database. 
+     * @brief While a thread has a SqliteTransaction or SqliteSavepoint active, other threads wait to use the database until it ends, so their commands never join the transaction.
+     * @brief This includes stepping and resetting statements created by the database before the transaction began.
      */
     class SqliteDatabase
     {
@@ -65,6 +76,11 @@ namespace Nickvision::Database
          * @brief Destructs a SqliteDatabase.
          */
         ~SqliteDatabase() noexcept;
+        /**
+         * @brief Gets the event for when the progress of a backup has changed.
+         * @return The backup progress changed event
+         */
+        Events::Event<SqliteBackupProgressChangedEventArgs>& backupProgressChanged() noexcept;
         /**
          * @brief Gets the path of the database file.
          * @return The database file path
@@ -94,22 +110,66 @@ namespace Nickvision::Database
          * @brief If the database is encrypted and locked, this method will return false.
          * @brief If the database is encrypted and unlocked and the password is empty, it will be decrypted.
          * @brief If the database is encrypted and unlocked and the password is not empty, it will be reencrypted with the new password.
+         * @brief If a backup of the database is running, this method will return false.
          * @param password The new database password
          * @return True if successful, else false
          * @throw std::runtime_error Thrown if database cannot be opened
          */
         bool setPassword(const std::string& password);
+        /**
+         * @brief Copies the database to a file while it remains in use, using sqlite's online backup API.
+         * @brief Pages are copied in chunks and the database is only locked while a chunk is copied, so other operations can run between chunks. The backupProgressChanged event is invoked after each chunk.
+         * @brief The copy is written to a temporary file that replaces the destination once complete, so the destination never holds a partial copy.
+         * @brief While a backup is running, setPassword() fails.
+         * @param destination The path of the file to copy the database to
+         * @param password The password of the copy, which must be the database's password if it is encrypted (sqlcipher cannot change encryption during a backup)
+         * @param token An optional token to cancel the backup
+         * @return True if the database was copied, else false (including if the backup was cancelled)
+         */
+        bool backup(const std::filesystem::path& destination, const std::string& password = "", const std::shared_ptr<Helpers::CancellationToken>& token = nullptr) noexcept;
         /**
          * @brief Registers a custom sql function to the database.
          * @param name The name of the sql function
          * @param func The custom sql function
          * @param expectedArgs The number of args the sql function expects to receive (specify -1 for unlimited number of args)
+         * @param flags The behavior of the sql function
          * @return True if function registered, else false
          */
-        bool registerFunction(const std::string& name, const SqliteCustomFunction& func, int expectedArgs = -1) noexcept;
+        bool registerFunction(const std::string& name, const SqliteCustomFunction& func, int expectedArgs = -1, SqliteFunctionFlags flags = SqliteFunctionFlags::None) noexcept;
+        /**
+         * @brief Registers a custom sql aggregate function to the database.
+         * @brief If the function has value and inverse callbacks, it is registered as an aggregate window function.
+         * @param name The name of the sql function
+         * @param func The callbacks of the sql function
+         * @param expectedArgs The number of args the sql function expects to receive (specify -1 for unlimited number of args)
+         * @param flags The behavior of the sql function
+         * @return True if function registered, else false (including if step or final is missing, or only one of value and inverse is set)
+         */
+        bool registerAggregateFunction(const std::string& name, const SqliteAggregateFunction& func, int expectedArgs = -1, SqliteFunctionFlags flags = SqliteFunctionFlags::None) noexcept;
+        /**
+         * @brief Gets the maximum number of prepared statements the database keeps for reuse.
+         * @return The capacity of the statement cache
+         */
+        size_t getStatementCacheCapacity() const noexcept;
+        /**
+         * @brief Sets the maximum number of prepared statements the database keeps for reuse.
+         * @param capacity The capacity of the statement cache (0 to disable caching)
+         */
+        void setStatementCacheCapacity(size_t capacity) noexcept;
+        /**
+         * @brief Gets the number of statements created from the statement cache.
+         * @return The number of statement cache hits
+         */
+        size_t getStatementCacheHits() const noexcept;
+        /**
+         * @brief Gets the number of statements that had to be prepared because they were not in the statement cache.
+         * @return The number of statement cache misses
+         */
+        size_t getStatementCacheMisses() const noexcept;
         /**
          * @brief Creates a new SqlStatement for the database.
          * @brief Executing the statement is controlled by calling step() on the statement object.
+         * @brief Prepared statements are cached by their command. When the returned statement is destroyed, it is reset, its bindings are cleared and it is returned to the cache.
          * @param command The command to bind to the statement.
          * @return The new SqlStatement if successful
          * @return An empty SqlStatement if failed (can be checked with operator bool())
@@ -122,6 +182,63 @@ namespace Nickvision::Database
          * @return True if command returned SQLITE_OK, else false
          */
         bool execute(const std::string& command) noexcept;
+        /**
+         * @brief Interrupts the sql commands running on the database, which will fail with SQLITE_INTERRUPT.
+         * @brief Unlike other methods, this method does not wait for running commands and may be called from any thread.
+         */
+        void interrupt() noexcept;
+        /**
+         * @brief Inserts rows into the database within a single savepoint, reusing one prepared statement.
+         * @brief If any row fails to insert, all rows are rolled back.
+         * @tparam Range The type of the range of rows
+         * @tparam Binder The type of the binder, callable as bool(SqliteStatement&, const Row&)
+         * @param command The insert command, with a parameter for each value of a row
+         * @param rows The rows to insert
+         * @param binder The function that binds the values of a row to the statement, returning false if a bind failed
+         * @return True if all rows were inserted, else false
+         * @throw std::runtime_error Thrown if the savepoint or the statement cannot be created
+         */
+        template<std::ranges::input_range Range, typename Binder>
+        bool bulkInsert(const std::string& command, Range&& rows, Binder&& binder)
+        {
+            SqliteSavepoint savepoint{ *this };
+            SqliteStatement statement{ createStatement(command) };
+            if(!statement)
+            {
+                return false;
+            }
+            for(const auto& row : rows)
+            {
+                if(!binder(statement, row) || statement.step() != SqliteStepResult::Done)
+                {
+                    return false;
+                }
+                statement.reset();
+            }
+            return savepoint.release();
+        }
+        /**
+         * @brief Inserts rows of tuples into the database within a single savepoint, reusing one prepared statement.
+         * @brief The values of each tuple are bound to the parameters of the command in order.
+         * @brief If any row fails to insert, all rows are rolled back.
+         * @tparam Range The type of the range of tuples (whose elements are SupportedSqliteValues)
+         * @param command The insert command, with a parameter for each value of a tuple
+         * @param rows The rows to insert
+         * @return True if all rows were inserted, else false
+         * @throw std::runtime_error Thrown if the savepoint or the statement cannot be created
+         */
+        template<std::ranges::input_range Range>
+        bool bulkInsert(const std::string& command, Range&& rows)
+        {
+            return bulkInsert(command, std::forward<Range>(rows), [](SqliteStatement& statement, const auto& row)
+            {
+                return std::apply([&statement](const auto&... values)
+                {
+                    int index{ 1 };
+                    return (statement.bind(index++, values) && ...);
+                }, row);
+            });
+        }
         SqliteDatabase& operator=(const SqliteDatabase&) = delete;
         /**
          * @brief Assigns a SqliteDatabase via move.
@@ -131,13 +248,34 @@ namespace Nickvision::Database
         SqliteDatabase& operator=(SqliteDatabase&& other) noexcept;
 
     private:
+        friend class SqliteSavepoint;
+        friend class SqliteTransaction;
+        /**
+         * @brief Replaces the database file with an exported copy that has a different password, reopening the database.
+         * @brief The mutex must be held by the caller. If the export fails, the database is left unchanged.
+         * @param password The password of the exported copy (empty for no encryption)
+         * @return True if successful, else false
+         * @throw std::runtime_error Thrown if database cannot be reopened
+         */
+        bool replaceWithExport(const std::string& password);
+        /**
+         * @brief Locks the mutex held by active transactions and savepoints.
+         * @brief This mutex must be locked before m_mutex.
+         * @return The lock, which is empty if the database was moved from
+         */
+        std::unique_lock<std::recursive_mutex> lockTransactions() const noexcept;
         mutable std::mutex m_mutex;
         std::filesystem::path m_path;
         int m_flags;
         bool m_isEncrypted;
         bool m_isUnlocked;
         sqlite3* m_database;
+        size_t m_runningBackups;
+        std::shared_ptr<std::recursive_mutex> m_transactionMutex;
         std::unordered_map<std::string, SqliteCustomFunction> m_customFunctions;
+        std::unordered_map<std::string, SqliteAggregateFunction> m_aggregateFunctions;
+        Events::Event<SqliteBackupProgressChangedEventArgs> m_backupProgressChanged;
+        std::shared_ptr<SqliteStatementCache> m_statementCache;
     };
 }
 
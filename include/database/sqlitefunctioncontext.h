@@ -23,9 +23,11 @@
 #ifndef SQLITEFUNCTIONCONTEXT_H
 #define SQLITEFUNCTIONCONTEXT_H
 
+#include <new>
 #include <vector>
 #include "sqlite.h"
 #include "sqlitevalue.h"
+#include "sqlitevalueview.h"
 
 namespace Nickvision::Database
 {
@@ -53,11 +55,50 @@ namespace Nickvision::Database
          * @return The user data pointer
          */
         void* getUserData() const noexcept;
+        /**
+         * @brief Gets the number of arguments passed to the function.
+         * @return The number of arguments
+         */
+        int getArgCount() const noexcept;
+        /**
+         * @brief Gets an argument passed to the function without copying it.
+         * @param index The index of the argument
+         * @return The argument (a view of NULL if index is out of range)
+         */
+        SqliteValueView getArg(int index) const noexcept;
         /**
          * @brief Gets the list of SqliteValue arguments passed to the function.
+         * @brief The arguments are copied on the first call. Prefer getArg() to read arguments without copying them.
          * @return The list of arguments
          */
         const std::vector<SqliteValue>& getArgs() const noexcept;
+        /**
+         * @brief Gets the state of the current group of an aggregate or window function.
+         * @brief The state is value-initialized on first access and destroyed after the function's final callback.
+         * @brief This method may only be called from the callbacks of an aggregate or window function, which must all use the same type T.
+         * @tparam T The type of the state
+         * @return The state
+         * @throw std::bad_alloc Thrown if the state cannot be allocated
+         */
+        template<typename T>
+        T& getState()
+        {
+            AggregateState* state{ m_context ? static_cast<AggregateState*>(sqlite3_aggregate_context(m_context, sizeof(AggregateState))) : nullptr };
+            if(!state)
+            {
+                throw std::bad_alloc();
+            }
+            //sqlite zero-fills the aggregate context when it is first allocated
+            if(!state->data)
+            {
+                state->data = new T{};
+                state->destroy = [](void* data)
+                {
+                    delete static_cast<T*>(data);
+                };
+            }
+            return *static_cast<T*>(state->data);
+        }
         /**
          * @brief Returns a NULL value from the sql function. 
          */
@@ -78,7 +119,7 @@ namespace Nickvision::Database
             {
                 sqlite3_result_int(m_context, value);
             }
-            else if constexpr (std::is_same_v<T, sqlite3_int64>)
+            else if constexpr (std::is_same_v<T, std::int64_t>)
             {
                 sqlite3_result_int64(m_context, value);
             }
@@ -92,9 +133,29 @@ namespace Nickvision::Database
             }
             else if constexpr (std::is_same_v<T, std::string>)
             {
-                sqlite3_result_text(m_context, value.c_str(), value.size(), SQLITE_TRANSIENT);
+                sqlite3_result_text64(m_context, value.c_str(), value.size(), SQLITE_TRANSIENT, SQLITE_UTF8);
+            }
+            else if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                sqlite3_result_text64(m_context, value.empty() ? "" : value.data(), value.size(), SQLITE_TRANSIENT, SQLITE_UTF8);
+            }
+            else if constexpr (std::is_same_v<T, SqliteBlob> || std::is_same_v<T, SqliteBlobView>)
+            {
+                if(value.empty())
+                {
+                    sqlite3_result_zeroblob(m_context, 0);
+                }
+                else
+                {
+                    sqlite3_result_blob64(m_context, value.data(), value.size(), SQLITE_TRANSIENT);
+                }
             }
         }
+        /**
+         * @brief Returns a copy of a sqlite value from the sql function.
+         * @param value The value to return
+         */
+        void result(const SqliteValueView& value) noexcept;
         /**
          * @brief Returns an error from the sql function.
          * @param err The error message 
@@ -114,8 +175,23 @@ namespace Nickvision::Database
         SqliteFunctionContext& operator=(SqliteFunctionContext&& other) noexcept;
 
     private:
+        friend class SqliteDatabase;
+        /**
+         * @brief The state of a group of an aggregate or window function, stored in sqlite's aggregate context.
+         */
+        struct AggregateState
+        {
+            void* data;
+            void (*destroy)(void*);
+        };
+        /**
+         * @brief Destroys the state of the current group of an aggregate or window function, if any.
+         */
+        void destroyState() noexcept;
         sqlite3_context* m_context;
-        std::vector<SqliteValue> m_values;
+        int m_argc;
+        sqlite3_value** m_argv;
+        mutable std::vector<SqliteValue> m_values;
     };
 }
 
@@ -0,0 +1,44 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Flags to describe the behavior of a custom sqlite function.
+ */
+
+#ifndef SQLITEFUNCTIONFLAGS_H
+#define SQLITEFUNCTIONFLAGS_H
+
+#include "helpers/codehelpers.h"
+
+namespace Nickvision::Database
+{
+    /**
+     * @brief Flags to describe the behavior of a custom sqlite function.
+     */
+    enum class SqliteFunctionFlags
+    {
+        None = 0, ///< The function has no special behavior.
+        Deterministic = 1, ///< The function always returns the same result for the same arguments, allowing the query planner to factor it out of loops and use it in indexes.
+        Innocuous = 2, ///< The function has no side effects and does not leak information, allowing it to be used in views, triggers and schema definitions.
+        DirectOnly = 4 ///< The function may only be invoked from top-level sql, not from views, triggers or schema definitions.
+    };
+
+    DEFINE_ENUM_FLAGS(SqliteFunctionFlags)
+}
+
+#endif //SQLITEFUNCTIONFLAGS_H
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A sqlite savepoint.
+ */
+
+#ifndef SQLITESAVEPOINT_H
+#define SQLITESAVEPOINT_H
+
+#include <mutex>
+#include <string>
+
+namespace Nickvision::Database
+{
+    class SqliteDatabase;
+
+    /**
+     * @brief A sqlite savepoint, a nestable transaction.
+     * @brief The savepoint is rolled back when destroyed if it was not released, such as when an exception is thrown.
+     * @brief Outside of a transaction, the outermost savepoint begins a deferred transaction that is committed when it is released.
+     * @brief Savepoints must be released or rolled back in the reverse order they were created.
+     * @brief While the savepoint is active, other threads wait to use the database, so their statements never join it.
+     * @brief The savepoint must be released, rolled back and destroyed on the thread that created it.
+     */
+    class SqliteSavepoint
+    {
+    public:
+        /**
+         * @brief Constructs a SqliteSavepoint, creating the savepoint.
+         * @param database The database to create the savepoint on
+         * @throw std::runtime_error Thrown if the savepoint cannot be created
+         */
+        SqliteSavepoint(SqliteDatabase& database);
+        SqliteSavepoint(const SqliteSavepoint&) = delete;
+        SqliteSavepoint(SqliteSavepoint&&) = delete;
+        /**
+         * @brief Destructs a SqliteSavepoint, rolling it back if it is still active.
+         */
+        ~SqliteSavepoint() noexcept;
+        /**
+         * @brief Gets the name of the savepoint.
+         * @return The name of the savepoint
+         */
+        const std::string& getName() const noexcept;
+        /**
+         * @brief Gets whether or not the savepoint is still active (not released or rolled back).
+         * @return True if active, else false
+         */
+        bool isActive() const noexcept;
+        /**
+         * @brief Releases the savepoint, keeping its changes.
+         * @return True if successful, else false
+         */
+        bool release() noexcept;
+        /**
+         * @brief Rolls back the changes made since the savepoint was created and releases it.
+         * @return True if successful, else false
+         */
+        bool rollback() noexcept;
+        SqliteSavepoint& operator=(const SqliteSavepoint&) = delete;
+        SqliteSavepoint& operator=(SqliteSavepoint&&) = delete;
+
+    private:
+        SqliteDatabase& m_database;
+        std::string m_name;
+        std::unique_lock<std::recursive_mutex> m_lock;
+        bool m_isActive;
+    };
+}
+
+#endif //SQLITESAVEPOINT_H
@@ -23,11 +23,23 @@
 #ifndef SQLITESTATEMENT_H
 #define SQLITESTATEMENT_H
 
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 #include "sqlite.h"
+#include "sqlitestatementcache.h"
 #include "sqlitestepresult.h"
 
 namespace Nickvision::Database
 {
+    template<SqliteRow Row>
+    class SqliteRowRange;
+
     /**
      * @brief A sqlite statement. 
      */
@@ -49,6 +61,7 @@ namespace Nickvision::Database
         SqliteStatement(SqliteStatement&& other) noexcept;
         /**
          * @brief Destructs a SqliteStatement.
+         * @brief If the statement was created by a SqliteDatabase, it is reset and returned to the database's statement cache.
          */
         ~SqliteStatement() noexcept;
         /**
@@ -62,13 +75,15 @@ namespace Nickvision::Database
         void reset() noexcept;
         /**
          * @brief Binds a value to a sqlite parameter.
+         * @brief std::string and SqliteBlob values are copied by sqlite.
+         * @brief std::string_view and SqliteBlobView values are not copied and must remain valid until the parameter is rebound or the statement is reset or destroyed.
          * @tparam T The type of the value to bind
          * @param index The index of the parameter
          * @param value The value to bind
          * @return True if bind was successful, else false
          */
         template<SupportedSqliteValue T>
-        bool bind(int index, T value) noexcept
+        bool bind(int index, const T& value) noexcept
         {
             if(!m_statement)
             {
@@ -92,12 +107,33 @@ namespace Nickvision::Database
             }
             else if constexpr (std::is_same_v<T, std::string>)
             {
-                return sqlite3_bind_text(m_statement, index, value.c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK;
+                return sqlite3_bind_text64(m_statement, index, value.c_str(), value.size(), SQLITE_TRANSIENT, SQLITE_UTF8) == SQLITE_OK;
+            }
+            else if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                //An empty view may have no data pointer, which sqlite would bind as NULL instead of empty text
+                return sqlite3_bind_text64(m_statement, index, value.empty() ? "" : value.data(), value.size(), SQLITE_STATIC, SQLITE_UTF8) == SQLITE_OK;
+            }
+            else if constexpr (std::is_same_v<T, SqliteBlob> || std::is_same_v<T, SqliteBlobView>)
+            {
+                if(value.empty())
+                {
+                    return sqlite3_bind_zeroblob(m_statement, index, 0) == SQLITE_OK;
+                }
+                return sqlite3_bind_blob64(m_statement, index, value.data(), value.size(), std::is_same_v<T, SqliteBlob> ? SQLITE_TRANSIENT : SQLITE_STATIC) == SQLITE_OK;
             }
         }
+        /**
+         * @brief Binds NULL to a sqlite parameter.
+         * @param index The index of the parameter
+         * @return True if bind was successful, else false
+         */
+        bool bindNull(int index) noexcept;
         /**
          * @brief Gets the sqlite column value as a specific type.
-         * @tparam T The type to get the sqlite column value as (Can be: int, std::int64_t, double, bool, std::string)
+         * @brief std::string_view and SqliteBlobView values point into the statement and are only valid until the next call to step(), reset() or getColumn() of a different type for the column.
+         * @tparam T The type to get the sqlite column value as (Can be: int, std::int64_t, double, bool, std::string, std::string_view, SqliteBlob, SqliteBlobView)
+         * @param index The index of the column
          * @return The sqlite column value as the specified type
          * @return A default value if the sqlite column value is not of the specified type
          */
@@ -144,6 +180,87 @@ namespace Nickvision::Database
                 }
                 return { reinterpret_cast<const char*>(sqlite3_column_text(m_statement, index)), static_cast<size_t>(sqlite3_column_bytes(m_statement, index)) };
             }
+            else if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                if(!m_statement)
+                {
+                    return {};
+                }
+                //sqlite3_column_text() must be called before sqlite3_column_bytes() so the size is of the converted text
+                const char* text{ reinterpret_cast<const char*>(sqlite3_column_text(m_statement, index)) };
+                if(!text)
+                {
+                    return {};
+                }
+                return { text, static_cast<size_t>(sqlite3_column_bytes(m_statement, index)) };
+            }
+            else if constexpr (std::is_same_v<T, SqliteBlob> || std::is_same_v<T, SqliteBlobView>)
+            {
+                if(!m_statement)
+                {
+                    return {};
+                }
+                const std::byte* blob{ static_cast<const std::byte*>(sqlite3_column_blob(m_statement, index)) };
+                if(!blob)
+                {
+                    return {};
+                }
+                SqliteBlobView view{ blob, static_cast<size_t>(sqlite3_column_bytes(m_statement, index)) };
+                if constexpr (std::is_same_v<T, SqliteBlob>)
+                {
+                    return { view.begin(), view.end() };
+                }
+                else
+                {
+                    return view;
+                }
+            }
+        }
+        /**
+         * @brief Gets whether or not a sqlite column value is NULL.
+         * @param index The index of the column
+         * @return True if NULL, else false
+         */
+        bool isColumnNull(int index) noexcept;
+        /**
+         * @brief Gets the current row of the statement as a specific type.
+         * @brief The columns of the row are decoded in order as the column types of the row type.
+         * @tparam Row The type of the row (A std::tuple of SupportedSqliteValues or a type with a nested SqliteColumns tuple)
+         * @return The current row
+         */
+        template<SqliteRow Row>
+        Row getRow() noexcept
+        {
+            return getRow<Row>(std::make_index_sequence<std::tuple_size_v<typename SqliteRowTraits<Row>::Columns>>{});
+        }
+        /**
+         * @brief Gets an input range over the remaining rows of the statement.
+         * @brief The range steps the statement as it is iterated. Rows with view columns are only valid until the range is advanced.
+         * @tparam Row The type of the rows (A std::tuple of SupportedSqliteValues or a type with a nested SqliteColumns tuple)
+         * @return The range of rows
+         */
+        template<SqliteRow Row>
+        SqliteRowRange<Row> rows() noexcept;
+        /**
+         * @brief Steps through all remaining rows of the statement, appending them to a vector.
+         * @tparam Row The type of the rows (A std::tuple of SupportedSqliteValues or a type with a nested SqliteColumns tuple, without view columns)
+         * @param rows The vector to append the rows to
+         * @param expectedRows The number of rows to reserve space for in the vector before stepping
+         * @return True if all rows were fetched, else false if a step failed
+         */
+        template<SqliteOwningRow Row>
+        bool fetchAll(std::vector<Row>& rows, size_t expectedRows = 0) noexcept
+        {
+            if(expectedRows > 0)
+            {
+                rows.reserve(rows.size() + expectedRows);
+            }
+            SqliteStepResult result{ step() };
+            for(; result == SqliteStepResult::Row; result = step())
+            {
+                rows.push_back(getRow<Row>());
+            }
+            return result == SqliteStepResult::Done;
         }
         SqliteStatement& operator=(const SqliteStatement&) = delete;
         /**
@@ -159,8 +276,179 @@ namespace Nickvision::Database
         operator bool() const noexcept;
 
     private:
+        friend class SqliteDatabase;
+        /**
+         * @brief Constructs a SqliteStatement that is returned to a cache when destroyed.
+         * @param statement The prepared sqlite3 statement
+         * @param cache The cache to return the statement to
+         * @param key The key of the statement in the cache (the command it was created from)
+         * @param transactionMutex The mutex held by the database's active transactions, locked while the statement is stepped or reset
+         */
+        SqliteStatement(sqlite3_stmt* statement, const std::shared_ptr<SqliteStatementCache>& cache, std::string&& key, const std::shared_ptr<std::recursive_mutex>& transactionMutex) noexcept;
+        /**
+         * @brief Locks the mutex held by the database's active transactions.
+         * @return The lock, which is empty if the statement was not created by a SqliteDatabase
+         */
+        std::unique_lock<std::recursive_mutex> lockTransactions() const noexcept;
+        /**
+         * @brief Returns the statement to its cache, or finalizes it if it has none.
+         */
+        void close() noexcept;
+        /**
+         * @brief Gets the current row of the statement as a specific type.
+         * @tparam Row The type of the row
+         * @tparam I The indexes of the columns of the row
+         * @return The current row
+         */
+        template<SqliteRow Row, size_t... I>
+        Row getRow(std::index_sequence<I...>) noexcept
+        {
+            return Row{ getColumn<std::tuple_element_t<I, typename SqliteRowTraits<Row>::Columns>>(static_cast<int>(I))... };
+        }
         sqlite3_stmt* m_statement;
+        std::weak_ptr<SqliteStatementCache> m_cache;
+        std::string m_key;
+        std::shared_ptr<std::recursive_mutex> m_transactionMutex;
     };
+
+    /**
+     * @brief An input range over the rows of a SqliteStatement.
+     * @tparam Row The type of the rows
+     */
+    template<SqliteRow Row>
+    class SqliteRowRange
+    {
+    public:
+        /**
+         * @brief An iterator over the rows of a SqliteRowRange.
+         */
+        class Iterator
+        {
+        public:
+            using value_type = Row;
+            using difference_type = std::ptrdiff_t;
+            /**
+             * @brief Constructs an Iterator at the end of a range.
+             */
+            Iterator() noexcept
+                : m_range{ nullptr }
+            {
+
+            }
+            /**
+             * @brief Gets the current row.
+             * @return The current row
+             */
+            const Row& operator*() const noexcept
+            {
+                return *m_range->m_row;
+            }
+            /**
+             * @brief Advances to the next row.
+             * @return Reference to this Iterator
+             */
+            Iterator& operator++() noexcept
+            {
+                m_range->next();
+                return *this;
+            }
+            /**
+             * @brief Advances to the next row.
+             */
+            void operator++(int) noexcept
+            {
+                m_range->next();
+            }
+            /**
+             * @brief Gets whether or not the iterator is at the end of the range.
+             * @return True if at the end, else false
+             */
+            bool operator==(std::default_sentinel_t) const noexcept
+            {
+                return !m_range || !m_range->m_row;
+            }
+
+        private:
+            friend class SqliteRowRange;
+            /**
+             * @brief Constructs an Iterator.
+             * @param range The range to iterate
+             */
+            Iterator(SqliteRowRange* range) noexcept
+                : m_range{ range }
+            {
+
+            }
+            SqliteRowRange* m_range;
+        };
+
+        /**
+         * @brief Constructs a SqliteRowRange.
+         * @param statement The statement to step through
+         */
+        SqliteRowRange(SqliteStatement& statement) noexcept
+            : m_statement{ &statement },
+            m_started{ false },
+            m_error{ false }
+        {
+
+        }
+        /**
+         * @brief Gets an iterator to the current row, stepping to the first row if the range has not been started.
+         * @return The iterator
+         */
+        Iterator begin() noexcept
+        {
+            if(!m_started)
+            {
+                m_started = true;
+                next();
+            }
+            return { this };
+        }
+        /**
+         * @brief Gets the end of the range.
+         * @return The sentinel of the range
+         */
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+        /**
+         * @brief Gets whether or not the range ended because a step failed.
+         * @return True if a step failed, else false
+         */
+        bool hasError() const noexcept
+        {
+            return m_error;
+        }
+
+    private:
+        /**
+         * @brief Steps the statement to the next row.
+         */
+        void next() noexcept
+        {
+            SqliteStepResult result{ m_statement->step() };
+            if(result == SqliteStepResult::Row)
+            {
+                m_row = m_statement->getRow<Row>();
+                return;
+            }
+            m_row.reset();
+            m_error = result == SqliteStepResult::Error;
+        }
+        SqliteStatement* m_statement;
+        std::optional<Row> m_row;
+        bool m_started;
+        bool m_error;
+    };
+
+    template<SqliteRow Row>
+    SqliteRowRange<Row> SqliteStatement::rows() noexcept
+    {
+        return { *this };
+    }
 }
 
 #endif //SQLITESTATEMENT_H
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A least recently used cache of prepared sqlite statements.
+ */
+
+#ifndef SQLITESTATEMENTCACHE_H
+#define SQLITESTATEMENTCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include "sqlite.h"
+
+namespace Nickvision::Database
+{
+    /**
+     * @brief A least recently used cache of prepared sqlite statements, keyed by their sql.
+     * @brief Statements are taken out of the cache while in use, so a cached statement is never used by two owners at once.
+     */
+    class SqliteStatementCache
+    {
+    public:
+        /**
+         * @brief Constructs a SqliteStatementCache.
+         * @param capacity The maximum number of statements to keep (0 to disable caching)
+         */
+        SqliteStatementCache(size_t capacity) noexcept;
+        SqliteStatementCache(const SqliteStatementCache&) = delete;
+        SqliteStatementCache(SqliteStatementCache&&) = delete;
+        /**
+         * @brief Destructs a SqliteStatementCache, finalizing all cached statements.
+         */
+        ~SqliteStatementCache() noexcept;
+        /**
+         * @brief Gets the maximum number of statements to keep.
+         * @return The capacity of the cache
+         */
+        size_t getCapacity() const noexcept;
+        /**
+         * @brief Sets the maximum number of statements to keep.
+         * @brief If the cache holds more statements, the least recently used ones are finalized.
+         * @param capacity The capacity of the cache (0 to disable caching)
+         */
+        void setCapacity(size_t capacity) noexcept;
+        /**
+         * @brief Gets the number of statements in the cache.
+         * @return The number of statements in the cache
+         */
+        size_t size() const noexcept;
+        /**
+         * @brief Gets the number of times a statement was found in the cache.
+         * @return The number of cache hits
+         */
+        size_t getHits() const noexcept;
+        /**
+         * @brief Gets the number of times a statement was not found in the cache.
+         * @return The number of cache misses
+         */
+        size_t getMisses() const noexcept;
+        /**
+         * @brief Sets the database the cached statements belong to.
+         * @brief All cached statements are finalized in the same critical section, so no statement of the old database can be cached for the new one.
+         * @brief Statements of other databases released later are finalized instead of cached.
+         * @param database The sqlite3 database
+         */
+        void setDatabase(sqlite3* database) noexcept;
+        /**
+         * @brief Takes a statement out of the cache.
+         * @param command The command the statement was created from
+         * @param key Set to the key of the cached statement (equal to command), which must be passed back to release()
+         * @return The cached statement, or nullptr if none is cached
+         */
+        sqlite3_stmt* acquire(std::string_view command, std::string& key) noexcept;
+        /**
+         * @brief Returns a statement to the cache.
+         * @brief The statement is reset and its bindings are cleared. If it cannot be cached, it is finalized.
+         * @brief Statements are keyed by the command they were created from rather than by sqlite3_sql(), which drops anything after the first statement of the command.
+         * @param statement The statement
+         * @param key The command the statement was created from
+         */
+        void release(sqlite3_stmt* statement, std::string&& key) noexcept;
+        /**
+         * @brief Finalizes all cached statements.
+         */
+        void clear() noexcept;
+        SqliteStatementCache& operator=(const SqliteStatementCache&) = delete;
+        SqliteStatementCache& operator=(SqliteStatementCache&&) = delete;
+
+    private:
+        /**
+         * @brief Finalizes all cached statements.
+         * @brief m_mutex must be locked by the caller.
+         */
+        void finalizeAll() noexcept;
+        /**
+         * @brief Finalizes the least recently used statements until the cache fits its capacity.
+         * @brief m_mutex must be locked by the caller.
+         */
+        void evict() noexcept;
+        mutable std::mutex m_mutex;
+        size_t m_capacity;
+        sqlite3* m_database;
+        std::list<std::pair<std::string, sqlite3_stmt*>> m_statements;
+        std::unordered_map<std::string_view, std::list<std::pair<std::string, sqlite3_stmt*>>::iterator> m_index;
+        size_t m_hits;
+        size_t m_misses;
+    };
+}
+
+#endif //SQLITESTATEMENTCACHE_H
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A sqlite transaction.
+ */
+
+#ifndef SQLITETRANSACTION_H
+#define SQLITETRANSACTION_H
+
+#include <mutex>
+
+namespace Nickvision::Database
+{
+    class SqliteDatabase;
+
+    /**
+     * @brief Types of sqlite transactions.
+     */
+    enum class SqliteTransactionType
+    {
+        Deferred, ///< The database is locked when it is first read or written
+        Immediate, ///< The database is locked for writing when the transaction begins
+        Exclusive ///< The database is locked for reading and writing when the transaction begins
+    };
+
+    /**
+     * @brief A sqlite transaction.
+     * @brief The transaction is rolled back when destroyed if it was not committed, such as when an exception is thrown.
+     * @brief Transactions cannot be nested, use SqliteSavepoint for nesting.
+     * @brief While the transaction is active, other threads wait to use the database, so their statements never join it.
+     * @brief The transaction must be committed, rolled back and destroyed on the thread that began it.
+     */
+    class SqliteTransaction
+    {
+    public:
+        /**
+         * @brief Constructs a SqliteTransaction, beginning the transaction.
+         * @param database The database to begin the transaction on
+         * @param type The type of transaction
+         * @throw std::runtime_error Thrown if the transaction cannot be begun
+         */
+        SqliteTransaction(SqliteDatabase& database, SqliteTransactionType type = SqliteTransactionType::Deferred);
+        SqliteTransaction(const SqliteTransaction&) = delete;
+        SqliteTransaction(SqliteTransaction&&) = delete;
+        /**
+         * @brief Destructs a SqliteTransaction, rolling it back if it is still active.
+         */
+        ~SqliteTransaction() noexcept;
+        /**
+         * @brief Gets whether or not the transaction is still active (not committed or rolled back).
+         * @return True if active, else false
+         */
+        bool isActive() const noexcept;
+        /**
+         * @brief Commits the transaction.
+         * @return True if successful, else false
+         */
+        bool commit() noexcept;
+        /**
+         * @brief Rolls back the transaction.
+         * @return True if successful, else false
+         */
+        bool rollback() noexcept;
+        SqliteTransaction& operator=(const SqliteTransaction&) = delete;
+        SqliteTransaction& operator=(SqliteTransaction&&) = delete;
+
+    private:
+        SqliteDatabase& m_database;
+        std::unique_lock<std::recursive_mutex> m_lock;
+        bool m_isActive;
+    };
+}
+
+#endif //SQLITETRANSACTION_H
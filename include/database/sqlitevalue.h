@@ -24,6 +24,7 @@
 #define SQLITEVALUE_H
 
 #include "sqlite.h"
+#include "sqlitevalueview.h"
 
 namespace Nickvision::Database
 {
@@ -54,53 +55,15 @@ namespace Nickvision::Database
         ~SqliteValue() noexcept;
         /**
          * @brief Gets the sqlite value as a specific type.
-         * @tparam T The type to get the sqlite value as (Can be: int, std::int64_t, double, bool, std::string)
+         * @brief std::string_view and SqliteBlobView values point into the sqlite value and are only valid while it is.
+         * @tparam T The type to get the sqlite value as (Can be: int, std::int64_t, double, bool, std::string, std::string_view, SqliteBlob, SqliteBlobView)
          * @return The sqlite value as the specified type
          * @return A default value if the sqlite value is not of the specified type
          */
         template<SupportedSqliteValue T>
         T as() const noexcept
         {
-            if constexpr (std::is_same_v<T, int>)
-            {
-                if(!m_value || m_type != SQLITE_INTEGER)
-                {
-                    return 0;
-                }
-                return sqlite3_value_int(m_value);
-            }
-            else if constexpr (std::is_same_v<T, std::int64_t>)
-            {
-                if(!m_value || m_type != SQLITE_INTEGER)
-                {
-                    return 0;
-                }
-                return sqlite3_value_int64(m_value);
-            }
-            else if constexpr (std::is_same_v<T, double>)
-            {
-                if(!m_value || m_type != SQLITE_FLOAT)
-                {
-                    return 0.0;
-                }
-                return sqlite3_value_double(m_value);
-            }
-            else if constexpr (std::is_same_v<T, bool>)
-            {
-                if(!m_value || m_type != SQLITE_INTEGER)
-                {
-                    return false;
-                }
-                return static_cast<bool>(sqlite3_value_int(m_value));
-            }
-            else if constexpr (std::is_same_v<T, std::string>)
-            {
-                if(!m_value || m_type != SQLITE3_TEXT)
-                {
-                    return "";
-                }
-                return { reinterpret_cast<const char*>(sqlite3_value_text(m_value)), static_cast<size_t>(sqlite3_value_bytes(m_value)) };
-            }
+            return SqliteValueView{ m_value }.as<T>();
         }
         /**
          * @brief Assigns a SqliteValue via copy.
@@ -0,0 +1,137 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A non-owning view of a sqlite value.
+ */
+
+#ifndef SQLITEVALUEVIEW_H
+#define SQLITEVALUEVIEW_H
+
+#include "sqlite.h"
+
+namespace Nickvision::Database
+{
+    /**
+     * @brief A non-owning view of a sqlite value.
+     * @brief The view is only valid while the sqlite value it points to is, such as for the duration of a custom function call.
+     */
+    class SqliteValueView
+    {
+    public:
+        /**
+         * @brief Constructs a SqliteValueView.
+         * @param value sqlite3_value*
+         */
+        SqliteValueView(sqlite3_value* value = nullptr) noexcept;
+        /**
+         * @brief Gets the sqlite datatype of the value.
+         * @return The datatype (SQLITE_INTEGER, SQLITE_FLOAT, SQLITE_TEXT, SQLITE_BLOB or SQLITE_NULL)
+         */
+        int getType() const noexcept;
+        /**
+         * @brief Gets whether or not the value is NULL.
+         * @return True if NULL, else false
+         */
+        bool isNull() const noexcept;
+        /**
+         * @brief Gets the sqlite value as a specific type.
+         * @brief std::string_view and SqliteBlobView values point into the sqlite value and are only valid while it is.
+         * @tparam T The type to get the sqlite value as (Can be: int, std::int64_t, double, bool, std::string, std::string_view, SqliteBlob, SqliteBlobView)
+         * @return The sqlite value as the specified type
+         * @return A default value if the sqlite value is not of the specified type
+         */
+        template<SupportedSqliteValue T>
+        T as() const noexcept
+        {
+            if constexpr (std::is_same_v<T, int>)
+            {
+                if(!m_value || m_type != SQLITE_INTEGER)
+                {
+                    return 0;
+                }
+                return sqlite3_value_int(m_value);
+            }
+            else if constexpr (std::is_same_v<T, std::int64_t>)
+            {
+                if(!m_value || m_type != SQLITE_INTEGER)
+                {
+                    return 0;
+                }
+                return sqlite3_value_int64(m_value);
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                if(!m_value || m_type != SQLITE_FLOAT)
+                {
+                    return 0.0;
+                }
+                return sqlite3_value_double(m_value);
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                if(!m_value || m_type != SQLITE_INTEGER)
+                {
+                    return false;
+                }
+                return static_cast<bool>(sqlite3_value_int(m_value));
+            }
+            else if constexpr (std::is_same_v<T, std::string>)
+            {
+                if(!m_value || m_type != SQLITE3_TEXT)
+                {
+                    return "";
+                }
+                return { reinterpret_cast<const char*>(sqlite3_value_text(m_value)), static_cast<size_t>(sqlite3_value_bytes(m_value)) };
+            }
+            else if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                if(!m_value || m_type != SQLITE3_TEXT)
+                {
+                    return {};
+                }
+                const char* text{ reinterpret_cast<const char*>(sqlite3_value_text(m_value)) };
+                return { text, text ? static_cast<size_t>(sqlite3_value_bytes(m_value)) : 0 };
+            }
+            else if constexpr (std::is_same_v<T, SqliteBlob> || std::is_same_v<T, SqliteBlobView>)
+            {
+                if(!m_value || m_type != SQLITE_BLOB)
+                {
+                    return {};
+                }
+                const std::byte* blob{ static_cast<const std::byte*>(sqlite3_value_blob(m_value)) };
+                SqliteBlobView view{ blob, blob ? static_cast<size_t>(sqlite3_value_bytes(m_value)) : 0 };
+                if constexpr (std::is_same_v<T, SqliteBlob>)
+                {
+                    return { view.begin(), view.end() };
+                }
+                else
+                {
+                    return view;
+                }
+            }
+        }
+
+    private:
+        friend class SqliteFunctionContext;
+        sqlite3_value* m_value;
+        int m_type;
+    };
+}
+
+#endif //SQLITEVALUEVIEW_H
@@ -0,0 +1,123 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A writer that atomically replaces the contents of a file.
+ */
+
+#ifndef ATOMICFILEWRITER_H
+#define ATOMICFILEWRITER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace Nickvision::Filesystem
+{
+    /**
+     * @brief A writer that atomically replaces the contents of a file.
+     * @brief Data is written to a temporary file in the same directory, which is renamed over the target file on commit.
+     * @brief Readers of the target file will only ever see its old or new contents, never a partial write.
+     * @brief Symbolic links are followed, so the file a link points to is replaced and the link is kept.
+     * @brief As the target file is replaced by a new file, its permissions are kept, but hard links to it, its ownership (if written by another user) and its extended attributes are not.
+     */
+    class AtomicFileWriter
+    {
+    public:
+        /**
+         * @brief Constructs an AtomicFileWriter.
+         * @param path The path of the file to write
+         * @param durable Whether or not to flush the file to the storage device before replacing the target file (much slower, but the new contents survive a power loss)
+         * @throw std::runtime_error Thrown if the temporary file cannot be created
+         */
+        AtomicFileWriter(const std::filesystem::path& path, bool durable = true);
+        /**
+         * @brief Destructs an AtomicFileWriter.
+         * @brief If the writer was not committed, the temporary file is removed and the target file is left untouched.
+         */
+        ~AtomicFileWriter() noexcept;
+        /**
+         * @brief Gets the path of the file being written.
+         * @brief If the path given to the constructor is a symbolic link, this is the path of the file it points to.
+         * @return The path of the file being written
+         */
+        const std::filesystem::path& getPath() const noexcept;
+        /**
+         * @brief Writes bytes to the file.
+         * @brief Small writes are buffered, large writes are passed directly to the operating system.
+         * @param bytes The bytes to write
+         * @return True if successful, else false
+         */
+        bool write(std::span<const std::byte> bytes) noexcept;
+        /**
+         * @brief Writes a string to the file.
+         * @param s The string to write
+         * @return True if successful, else false
+         */
+        bool write(std::string_view s) noexcept;
+        /**
+         * @brief Writes multiple buffers to the file with as few system calls as possible.
+         * @param buffers The buffers to write
+         * @return True if successful, else false
+         */
+        bool write(std::span<const std::span<const std::byte>> buffers) noexcept;
+        /**
+         * @brief Replaces the target file with the written data.
+         * @brief No further writes can be made after committing.
+         * @return True if successful, else false
+         */
+        bool commit() noexcept;
+        AtomicFileWriter(const AtomicFileWriter&) = delete;
+        AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+    private:
+        /**
+         * @brief Writes the buffered bytes to the temporary file.
+         * @return True if successful, else false
+         */
+        bool flush() noexcept;
+        /**
+         * @brief Writes bytes directly to the temporary file.
+         * @param data The bytes to write
+         * @param size The number of bytes to write
+         * @return True if successful, else false
+         */
+        bool writeDirect(const std::byte* data, size_t size) noexcept;
+        /**
+         * @brief Closes and removes the temporary file.
+         */
+        void discard() noexcept;
+        std::filesystem::path m_path;
+        std::filesystem::path m_tempPath;
+        bool m_durable;
+        bool m_failed;
+        std::vector<std::byte> m_buffer;
+#ifdef _WIN32
+        HANDLE m_file;
+#else
+        int m_file;
+#endif
+    };
+}
+
+#endif //ATOMICFILEWRITER_H
@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A reader for reading a file in chunks.
+ */
+
+#ifndef CHUNKEDFILEREADER_H
+#define CHUNKEDFILEREADER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+
+namespace Nickvision::Filesystem
+{
+    /**
+     * @brief A reader for reading a file in chunks.
+     * @brief Every chunk is read into the same buffer, so a file of any size can be processed with constant memory.
+     */
+    class ChunkedFileReader
+    {
+    public:
+        /**
+         * @brief Constructs a ChunkedFileReader.
+         * @param path The path of the file to read
+         * @param chunkSize The maximum number of bytes to read at a time
+         * @throw std::invalid_argument Thrown if chunkSize is 0
+         * @throw std::runtime_error Thrown if the file cannot be opened
+         */
+        ChunkedFileReader(const std::filesystem::path& path, size_t chunkSize = 64 * 1024);
+        /**
+         * @brief Gets the path of the file being read.
+         * @return The path of the file being read
+         */
+        const std::filesystem::path& getPath() const noexcept;
+        /**
+         * @brief Gets the maximum number of bytes read at a time.
+         * @return The chunk size
+         */
+        size_t getChunkSize() const noexcept;
+        /**
+         * @brief Gets whether or not the whole file has been read.
+         * @return True if the whole file has been read, else false
+         */
+        bool isEndOfFile() const noexcept;
+        /**
+         * @brief Reads the next chunk of the file.
+         * @brief The returned bytes are only valid until the next call to read().
+         * @return The bytes of the chunk, empty if the whole file has been read
+         */
+        std::span<const std::byte> read() noexcept;
+
+    private:
+        std::filesystem::path m_path;
+        size_t m_chunkSize;
+        std::unique_ptr<std::byte[]> m_buffer;
+        std::ifstream m_file;
+        bool m_endOfFile;
+    };
+}
+
+#endif //CHUNKEDFILEREADER_H
@@ -0,0 +1,45 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Functions for quickly scanning the contents of directories.
+ */
+
+#ifndef DIRECTORYSCANNER_H
+#define DIRECTORYSCANNER_H
+
+#include <filesystem>
+#include <vector>
+#include "scanflags.h"
+
+namespace Nickvision::Filesystem::DirectoryScanner
+{
+    /**
+     * @brief Scans the contents of a directory.
+     * @brief Recursive scans are spread across a pool of worker threads, one directory at a time.
+     * @brief Symbolic links to directories are reported as files, or as directories with ScanFlags::FollowSymlinks. They are never descended into.
+     * @brief Directories that cannot be read are skipped.
+     * @param path The path of the directory to scan
+     * @param flags The flags of what to collect
+     * @param threads The number of worker threads to use (specify 0 to use the number of hardware threads)
+     * @return The paths of the scanned entries, in no particular order (the root directory is not included)
+     */
+    std::vector<std::filesystem::path> scan(const std::filesystem::path& path, ScanFlags flags = ScanFlags::Files | ScanFlags::Directories | ScanFlags::Recursive, unsigned int threads = 0) noexcept;
+}
+
+#endif //DIRECTORYSCANNER_H
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A read-only memory mapped file.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace Nickvision::Filesystem
+{
+    /**
+     * @brief A read-only memory mapped file.
+     * @brief The contents of the file are paged in by the operating system on access, without being copied into a separate buffer.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @brief Constructs a MappedFile.
+         * @param path The path of the file to map
+         * @throw std::runtime_error Thrown if the file cannot be opened or mapped
+         */
+        MappedFile(const std::filesystem::path& path);
+        /**
+         * @brief Constructs a MappedFile via move.
+         * @param other The other MappedFile to move
+         */
+        MappedFile(MappedFile&& other) noexcept;
+        /**
+         * @brief Destructs a MappedFile.
+         */
+        ~MappedFile() noexcept;
+        /**
+         * @brief Gets the path of the mapped file.
+         * @return The path of the mapped file
+         */
+        const std::filesystem::path& getPath() const noexcept;
+        /**
+         * @brief Gets the size of the mapped file.
+         * @return The size of the mapped file in bytes
+         */
+        size_t size() const noexcept;
+        /**
+         * @brief Gets the bytes of the mapped file.
+         * @brief The bytes are only valid for the lifetime of the MappedFile.
+         * @return The bytes of the mapped file
+         */
+        std::span<const std::byte> getBytes() const noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        /**
+         * @brief Assigns a MappedFile via move.
+         * @param other The other MappedFile to move
+         * @return Reference to this MappedFile
+         */
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+    private:
+        /**
+         * @brief Unmaps the file.
+         */
+        void unmap() noexcept;
+        std::filesystem::path m_path;
+        const std::byte* m_data;
+        size_t m_size;
+    };
+}
+
+#endif //MAPPEDFILE_H
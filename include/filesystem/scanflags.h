@@ -0,0 +1,44 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Flags to describe what a directory scan should collect.
+ */
+
+#ifndef SCANFLAGS_H
+#define SCANFLAGS_H
+
+#include "helpers/codehelpers.h"
+
+namespace Nickvision::Filesystem
+{
+    /**
+     * @brief Flags to describe what a directory scan should collect.
+     */
+    enum class ScanFlags
+    {
+        Files = 1, ///< Include non-directory entries in the results.
+        Directories = 2, ///< Include directory entries in the results.
+        Recursive = 4, ///< Descend into subdirectories.
+        FollowSymlinks = 8 ///< Treat symbolic links to directories as directories (they are never descended into).
+    };
+
+    DEFINE_ENUM_FLAGS(ScanFlags)
+}
+
+#endif //SCANFLAGS_H
@@ -97,9 +97,10 @@ namespace Nickvision::Helpers::CodeHelpers
      * @param path The path to the file
      * @param bytes The bytes to write
      * @param overwrite Whether or not to overwrite the file if it already exists
+     * @param durable Whether or not to flush the file to the storage device before returning, so the write survives a power loss (much slower)
      * @return True if successful, false otherwise. False is returned if overwrite is false and the file exists.
      */
-    bool writeFileBytes(const std::filesystem::path& path, const std::vector<std::byte>& bytes, bool overwrite = true) noexcept;
+    bool writeFileBytes(const std::filesystem::path& path, const std::vector<std::byte>& bytes, bool overwrite = true, bool durable = false) noexcept;
 }
 
 #endif //CODEHELPERS_H
@@ -0,0 +1,100 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A string with a cached hash value.
+ */
+
+#ifndef HASHEDSTRING_H
+#define HASHEDSTRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace Nickvision::Helpers
+{
+    /**
+     * @brief A string with a cached hash value.
+     * @brief The hash is computed once on construction, making HashedString cheap to use as a key in hashed containers.
+     */
+    class HashedString
+    {
+    public:
+        /**
+         * @brief Constructs a HashedString.
+         * @param s The string
+         */
+        HashedString(std::string s = {}) noexcept;
+        /**
+         * @brief Constructs a HashedString.
+         * @param s The string
+         */
+        HashedString(std::string_view s) noexcept;
+        /**
+         * @brief Constructs a HashedString.
+         * @param s The string
+         */
+        HashedString(const char* s) noexcept;
+        /**
+         * @brief Gets the string.
+         * @return The string
+         */
+        const std::string& str() const noexcept;
+        /**
+         * @brief Gets the cached hash of the string.
+         * @return The hash of the string
+         */
+        std::uint64_t getHash() const noexcept;
+        /**
+         * @brief Compares two HashedStrings for equality.
+         * @brief The hashes are compared first, so unequal strings rarely need to be compared.
+         * @param other The other HashedString
+         * @return True if the strings are equal, else false
+         */
+        bool operator==(const HashedString& other) const noexcept;
+        /**
+         * @brief Converts the HashedString to a std::string_view.
+         * @return The string view
+         */
+        operator std::string_view() const noexcept;
+
+    private:
+        std::string m_string;
+        std::uint64_t m_hash;
+    };
+}
+
+namespace std
+{
+    /**
+     * @brief A hash value for HashedString, returning the cached hash.
+     */
+    template<>
+    struct hash<Nickvision::Helpers::HashedString>
+    {
+        size_t operator()(const Nickvision::Helpers::HashedString& s) const noexcept
+        {
+            return static_cast<size_t>(s.getHash());
+        }
+    };
+}
+
+#endif //HASHEDSTRING_H
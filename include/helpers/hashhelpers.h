@@ -0,0 +1,154 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Functions for fast, non-cryptographic hashing.
+ */
+
+#ifndef HASHHELPERS_H
+#define HASHHELPERS_H
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace Nickvision::Helpers::HashHelpers
+{
+    /**
+     * @brief A 128-bit hash value.
+     */
+    struct Hash128
+    {
+        std::uint64_t low;
+        std::uint64_t high;
+
+        auto operator<=>(const Hash128&) const noexcept = default;
+    };
+
+    /**
+     * @brief A streaming, non-cryptographic hasher based on wyhash's multiply-mix.
+     * @brief Data can be provided in any number of pieces, the result is the same as hashing all of it at once.
+     * @brief The hash values are stable across platforms and releases and may be persisted.
+     */
+    class Hasher
+    {
+    public:
+        /**
+         * @brief Constructs a Hasher.
+         * @param seed The seed of the hash
+         */
+        Hasher(std::uint64_t seed = 0) noexcept;
+        /**
+         * @brief Resets the hasher to its initial state.
+         * @param seed The seed of the hash
+         */
+        void reset(std::uint64_t seed = 0) noexcept;
+        /**
+         * @brief Adds bytes to the hash.
+         * @param bytes The bytes to add
+         * @return this
+         */
+        Hasher& update(std::span<const std::byte> bytes) noexcept;
+        /**
+         * @brief Adds a string to the hash.
+         * @param s The string to add
+         * @return this
+         */
+        Hasher& update(std::string_view s) noexcept;
+        /**
+         * @brief Gets the 64-bit hash of all data added so far.
+         * @brief More data can be added after getting the hash.
+         * @return The 64-bit hash
+         */
+        std::uint64_t digest64() const noexcept;
+        /**
+         * @brief Gets the 128-bit hash of all data added so far.
+         * @brief More data can be added after getting the hash.
+         * @return The 128-bit hash
+         */
+        Hash128 digest128() const noexcept;
+
+    private:
+        /**
+         * @brief Mixes a 48 byte stripe into the lanes.
+         * @param stripe The stripe to mix
+         */
+        void consume(const std::byte* stripe) noexcept;
+        /**
+         * @brief Mixes the buffered tail into a seed.
+         * @param seed The seed to mix the tail into
+         * @param a The first mixed word
+         * @param b The second mixed word
+         */
+        void finalize(std::uint64_t seed, std::uint64_t& a, std::uint64_t& b) const noexcept;
+        std::array<std::uint64_t, 3> m_lanes;
+        std::array<std::byte, 48> m_buffer;
+        size_t m_bufferSize;
+        std::uint64_t m_length;
+    };
+
+    /**
+     * @brief Gets the 64-bit hash of bytes.
+     * @param bytes The bytes to hash
+     * @param seed The seed of the hash
+     * @return The 64-bit hash
+     */
+    std::uint64_t hash64(std::span<const std::byte> bytes, std::uint64_t seed = 0) noexcept;
+    /**
+     * @brief Gets the 64-bit hash of a string.
+     * @param s The string to hash
+     * @param seed The seed of the hash
+     * @return The 64-bit hash
+     */
+    std::uint64_t hash64(std::string_view s, std::uint64_t seed = 0) noexcept;
+    /**
+     * @brief Gets the 128-bit hash of bytes.
+     * @param bytes The bytes to hash
+     * @param seed The seed of the hash
+     * @return The 128-bit hash
+     */
+    Hash128 hash128(std::span<const std::byte> bytes, std::uint64_t seed = 0) noexcept;
+    /**
+     * @brief Gets the 128-bit hash of a string.
+     * @param s The string to hash
+     * @param seed The seed of the hash
+     * @return The 128-bit hash
+     */
+    Hash128 hash128(std::string_view s, std::uint64_t seed = 0) noexcept;
+    /**
+     * @brief Gets the 128-bit hash of the contents of a file.
+     * @brief The result is the same as calling hash128() on the file's bytes.
+     * @param path The path of the file to hash
+     * @param seed The seed of the hash
+     * @return The 128-bit hash, { 0, 0 } if the file could not be read
+     */
+    Hash128 hashFile(const std::filesystem::path& path, std::uint64_t seed = 0) noexcept;
+    /**
+     * @brief Mixes two hash values into one.
+     * @param a The first hash value
+     * @param b The second hash value
+     * @return The mixed hash value
+     */
+    std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept;
+}
+
+#endif //HASHHELPERS_H
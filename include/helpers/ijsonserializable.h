@@ -19,6 +19,15 @@ namespace Nickvision::Helpers
          * @return The Json representation of the object
          */
         virtual boost::json::value toJson() const noexcept = 0;
+        /**
+         * @brief Serializes the object to a Json string.
+         * @brief Implementations can override this to write the string directly, without building a boost::json::value first.
+         * @return The Json string representation of the object
+         */
+        virtual std::string toJsonString() const noexcept
+        {
+            return boost::json::serialize(toJson());
+        }
     };
 
     template<typename T>
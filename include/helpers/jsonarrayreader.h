@@ -0,0 +1,105 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A reader that reads the elements of a Json array one at a time.
+ */
+
+#ifndef JSONARRAYREADER_H
+#define JSONARRAYREADER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <boost/json.hpp>
+#include "filesystem/chunkedfilereader.h"
+
+namespace Nickvision::Helpers
+{
+    /**
+     * @brief A reader that reads the elements of a Json array one at a time.
+     * @brief Only the element being read is held in memory, so arrays of any size can be read with memory proportional to their largest element.
+     */
+    class JsonArrayReader
+    {
+    public:
+        /**
+         * @brief Constructs a JsonArrayReader that reads from a file.
+         * @param path The path of the file to read
+         * @throw std::runtime_error Thrown if the file cannot be opened
+         */
+        JsonArrayReader(const std::filesystem::path& path);
+        /**
+         * @brief Constructs a JsonArrayReader that reads from memory.
+         * @param json The bytes of the Json string, which must outlive the reader
+         */
+        JsonArrayReader(std::span<const std::byte> json) noexcept;
+        /**
+         * @brief Gets the number of elements read.
+         * @return The number of elements read
+         */
+        size_t getCount() const noexcept;
+        /**
+         * @brief Gets whether or not the input is not a valid Json array.
+         * @brief Errors are only detected as far as the input has been read.
+         * @return True if the input is invalid, else false
+         */
+        bool hasError() const noexcept;
+        /**
+         * @brief Reads the next element of the array.
+         * @return The next element, or std::nullopt if the end of the array was reached or the input is invalid
+         */
+        std::optional<boost::json::value> next() noexcept;
+
+    private:
+        /**
+         * @brief The position of the reader in the array.
+         */
+        enum class State
+        {
+            Start,
+            FirstElement,
+            Element,
+            End,
+            Error
+        };
+        /**
+         * @brief Makes sure there is unread input in the current chunk.
+         * @return True if there is unread input, false if the end of the input was reached
+         */
+        bool fill() noexcept;
+        /**
+         * @brief Marks the input as invalid.
+         * @return std::nullopt
+         */
+        std::nullopt_t fail() noexcept;
+        std::unique_ptr<Filesystem::ChunkedFileReader> m_file;
+        std::string_view m_chunk;
+        size_t m_position;
+        std::string m_element;
+        boost::json::parser m_parser;
+        State m_state;
+        size_t m_count;
+    };
+}
+
+#endif //JSONARRAYREADER_H
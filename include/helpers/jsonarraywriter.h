@@ -0,0 +1,105 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A writer that streams a Json array to a file or string.
+ */
+
+#ifndef JSONARRAYWRITER_H
+#define JSONARRAYWRITER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <boost/json.hpp>
+#include "filesystem/atomicfilewriter.h"
+#include "ijsonserializable.h"
+
+namespace Nickvision::Helpers
+{
+    /**
+     * @brief A writer that streams a Json array to a file or string.
+     * @brief Each element is serialized and written as soon as it is added, so the whole array is never held in memory.
+     */
+    class JsonArrayWriter
+    {
+    public:
+        /**
+         * @brief Constructs a JsonArrayWriter that writes to a file.
+         * @brief The file is only replaced once finish() succeeds.
+         * @param path The path of the file to write
+         * @throw std::runtime_error Thrown if the file cannot be created
+         */
+        JsonArrayWriter(const std::filesystem::path& path);
+        /**
+         * @brief Constructs a JsonArrayWriter that appends to a string.
+         * @param buffer The string to append to, which must outlive the writer
+         */
+        JsonArrayWriter(std::string& buffer) noexcept;
+        /**
+         * @brief Gets the number of elements written.
+         * @return The number of elements written
+         */
+        size_t getCount() const noexcept;
+        /**
+         * @brief Gets whether or not the array has been finished.
+         * @return True if finished, else false
+         */
+        bool isFinished() const noexcept;
+        /**
+         * @brief Writes an element to the array.
+         * @param element The element to write
+         * @return True if successful, else false
+         */
+        bool write(const IJsonSerializable& element) noexcept;
+        /**
+         * @brief Writes an element to the array.
+         * @brief The element is serialized in pieces, so its serialized string is never held in memory.
+         * @param element The element to write
+         * @return True if successful, else false
+         */
+        bool write(const boost::json::value& element) noexcept;
+        /**
+         * @brief Closes the array.
+         * @brief No more elements can be written after the array is finished.
+         * @return True if successful, else false
+         */
+        bool finish() noexcept;
+
+    private:
+        /**
+         * @brief Writes the separator before the next element.
+         * @return True if successful, else false
+         */
+        bool beginElement() noexcept;
+        /**
+         * @brief Writes a string to the file or string.
+         * @param s The string to write
+         * @return True if successful, else false
+         */
+        bool append(std::string_view s) noexcept;
+        std::unique_ptr<Filesystem::AtomicFileWriter> m_file;
+        std::string* m_buffer;
+        size_t m_count;
+        bool m_finished;
+    };
+}
+
+#endif //JSONARRAYWRITER_H
@@ -0,0 +1,223 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Functions for serializing objects to and from Json using field descriptors.
+ */
+
+#ifndef JSONFIELDS_H
+#define JSONFIELDS_H
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <boost/json.hpp>
+
+namespace Nickvision::Helpers
+{
+    template<typename T>
+    concept SupportedJsonField = std::is_arithmetic_v<T> ||
+        std::is_same_v<T, std::string> ||
+        std::is_same_v<T, boost::json::value> ||
+        std::is_same_v<T, boost::json::array> ||
+        std::is_same_v<T, boost::json::object>;
+
+    /**
+     * @brief A descriptor of a member of a class that is serialized to Json.
+     * @tparam Class The type of the class
+     * @tparam Member The type of the member
+     */
+    template<typename Class, SupportedJsonField Member>
+    struct JsonField
+    {
+        /**
+         * @brief The key of the member in the Json object.
+         */
+        std::string_view name;
+        /**
+         * @brief A pointer to the member.
+         */
+        Member Class::* member;
+    };
+
+    template<typename Class, typename Member>
+    JsonField(std::string_view, Member Class::*) -> JsonField<Class, Member>;
+}
+
+namespace Nickvision::Helpers::JsonFields
+{
+    /**
+     * @brief Appends a string to a Json string as a quoted and escaped Json string.
+     * @param json The Json string to append to
+     * @param s The string to append
+     */
+    void appendString(std::string& json, std::string_view s) noexcept;
+    /**
+     * @brief Appends a value to a Json string.
+     * @param json The Json string to append to
+     * @param value The value to append
+     */
+    template<SupportedJsonField T>
+    void appendValue(std::string& json, const T& value) noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            json += value ? "true" : "false";
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            char buffer[24];
+            std::to_chars_result result{ std::to_chars(buffer, buffer + sizeof(buffer), value) };
+            json.append(buffer, result.ptr);
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            appendString(json, value);
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            //Doubles are formatted by boost::json, so they are written the same way as by boost::json::serialize()
+            json += boost::json::serialize(boost::json::value(static_cast<double>(value)));
+        }
+        else
+        {
+            json += boost::json::serialize(value);
+        }
+    }
+    /**
+     * @brief Reads a value from Json.
+     * @brief The value is left unchanged if the Json value is not of the expected type.
+     * @param json The Json value to read
+     * @param value The value to read into
+     */
+    template<SupportedJsonField T>
+    void readValue(const boost::json::value& json, T& value) noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            if(json.is_bool())
+            {
+                value = json.as_bool();
+            }
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            if(json.is_int64())
+            {
+                value = static_cast<T>(json.as_int64());
+            }
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            if(json.is_double())
+            {
+                value = static_cast<T>(json.as_double());
+            }
+            else if(json.is_int64())
+            {
+                value = static_cast<T>(json.as_int64());
+            }
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            if(json.is_string())
+            {
+                value = std::string_view{ json.as_string() };
+            }
+        }
+        else if constexpr (std::is_same_v<T, boost::json::array>)
+        {
+            if(json.is_array())
+            {
+                value = json.as_array();
+            }
+        }
+        else if constexpr (std::is_same_v<T, boost::json::object>)
+        {
+            if(json.is_object())
+            {
+                value = json.as_object();
+            }
+        }
+        else
+        {
+            value = json;
+        }
+    }
+    /**
+     * @brief Serializes the fields of an object to a Json object.
+     * @param object The object to serialize
+     * @param fields The descriptors of the fields to serialize
+     * @return The Json object
+     */
+    template<typename Class, typename... Members>
+    boost::json::object toObject(const Class& object, const std::tuple<JsonField<Class, Members>...>& fields) noexcept
+    {
+        boost::json::object json;
+        json.reserve(sizeof...(Members));
+        std::apply([&](const auto&... field)
+        {
+            (json.emplace(field.name, object.*field.member), ...);
+        }, fields);
+        return json;
+    }
+    /**
+     * @brief Serializes the fields of an object directly to a Json string.
+     * @param object The object to serialize
+     * @param fields The descriptors of the fields to serialize
+     * @return The Json string
+     */
+    template<typename Class, typename... Members>
+    std::string toString(const Class& object, const std::tuple<JsonField<Class, Members>...>& fields) noexcept
+    {
+        std::string json{ "{" };
+        std::apply([&](const auto&... field)
+        {
+            bool first{ true };
+            ((json += first ? "" : ",", first = false, appendString(json, field.name), json += ':', appendValue(json, object.*field.member)), ...);
+        }, fields);
+        json += '}';
+        return json;
+    }
+    /**
+     * @brief Deserializes the fields of an object from a Json object.
+     * @brief The Json object is walked once and each of its keys is matched against the field names, so no keys are hashed and no keys are inserted into the Json object.
+     * @brief Fields missing from the Json object, or whose Json values are not of the expected type, are left unchanged.
+     * @param json The Json object
+     * @param object The object to deserialize into
+     * @param fields The descriptors of the fields to deserialize
+     */
+    template<typename Class, typename... Members>
+    void fromObject(const boost::json::object& json, Class& object, const std::tuple<JsonField<Class, Members>...>& fields) noexcept
+    {
+        for(const boost::json::key_value_pair& pair : json)
+        {
+            std::string_view key{ pair.key() };
+            std::apply([&](const auto&... field)
+            {
+                //Stops at the first field with a matching name
+                static_cast<void>((... || (field.name == key && (readValue(pair.value(), object.*field.member), true))));
+            }, fields);
+        }
+    }
+}
+
+#endif //JSONFIELDS_H
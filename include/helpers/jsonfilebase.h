@@ -23,15 +23,26 @@
 #ifndef JSONFILEBASE_H
 #define JSONFILEBASE_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
 #include <boost/json.hpp>
 #include "events/event.h"
 #include "ijsonserializable.h"
 
 namespace Nickvision::Helpers
 {
+    template<SupportedJsonValue T>
+    class JsonProperty;
+
     /**
      * @brief A base class for thread-safe json data files.
      */
@@ -41,13 +52,17 @@ namespace Nickvision::Helpers
         /**
          * @brief Constructs a JsonFileBase, loading the file from disk.
          * @param path The path to the json file
+         * @param loadLazily Whether to defer loading the file until its values are first accessed, instead of loading it in the constructor
+         * @param useSnapshot Whether to keep a binary snapshot of the file next to it (at path + ".snapshot"), which is loaded instead of parsing the json file when it is up to date
          * @throw std::invalid_argument Thrown if the path is empty
          */
-        JsonFileBase(const std::filesystem::path& path);
+        JsonFileBase(const std::filesystem::path& path, bool loadLazily = false, bool useSnapshot = false);
         /**
          * @brief Destructs a JsonFileBase.
+         * @brief If auto save is enabled, any pending changes are saved first, without invoking the saved event.
+         * @brief A save already running on the auto save thread may still invoke the saved event, so derived classes whose saved handlers use derived members must call disableAutoSave() in their own destructor.
          */
-        virtual ~JsonFileBase() noexcept = default;
+        virtual ~JsonFileBase() noexcept;
         /**
          * @brief Gets the path of the json file.
          * @return The path of the json file
@@ -60,9 +75,63 @@ namespace Nickvision::Helpers
         Events::Event<Events::EventArgs>& saved() noexcept;
         /**
          * @brief Saves the config file to disk. 
+         * @brief The json object is only locked while a snapshot of it is taken, serialization happens without blocking readers and writers.
+         * @brief If the journal is enabled, only the changed top-level values are copied and appended to the journal until it grows past its compaction size.
          * @return True if saved to disk, else false
          */
         bool save() noexcept;
+        /**
+         * @brief Gets whether or not durable saves are enabled.
+         * @return True if durable saves are enabled, else false
+         */
+        bool isDurableSaveEnabled() const noexcept;
+        /**
+         * @brief Enables durable saves.
+         * @brief Saves flush the file (or journal) to the storage device before returning, so they survive a power loss at the cost of a much slower save.
+         * @brief Without durable saves, a save is still atomic: after a crash of the application, the file holds either its old or its new contents.
+         */
+        void enableDurableSave() noexcept;
+        /**
+         * @brief Disables durable saves.
+         */
+        void disableDurableSave() noexcept;
+        /**
+         * @brief Gets whether or not the journal is enabled.
+         * @return True if the journal is enabled, else false
+         */
+        bool isJournalEnabled() const noexcept;
+        /**
+         * @brief Enables the journal.
+         * @brief Saves append a JSON Patch (RFC 6902) of the changed values to a journal next to the file (at path + ".journal") instead of rewriting the whole file.
+         * @brief Changes are tracked per top-level key, so a changed array or object is written to the journal whole.
+         * @brief Once the journal grows past the compaction size, the next save rewrites the file and removes the journal.
+         * @brief The journal is always applied when the file is loaded, whether or not it is enabled.
+         * @param compactSize The size in bytes the journal may grow to before it is compacted into the file
+         */
+        void enableJournal(std::uint64_t compactSize = 1024 * 1024) noexcept;
+        /**
+         * @brief Disables the journal.
+         * @brief The next save rewrites the file and removes the journal.
+         */
+        void disableJournal() noexcept;
+        /**
+         * @brief Gets whether or not auto save is enabled.
+         * @return True if auto save is enabled, else false
+         */
+        bool isAutoSaveEnabled() const noexcept;
+        /**
+         * @brief Enables auto save.
+         * @brief Changes made with set() are saved on a background thread once the delay has passed since the first unsaved change.
+         * @brief All changes made within the delay are coalesced into a single write. The saved event is invoked from the background thread.
+         * @brief Derived classes whose saved handlers use derived members must call disableAutoSave() in their own destructor.
+         * @param delay The amount of time to wait before saving changes
+         */
+        void enableAutoSave(std::chrono::milliseconds delay = std::chrono::milliseconds{ 500 }) noexcept;
+        /**
+         * @brief Disables auto save.
+         * @brief Any pending changes are saved before returning.
+         */
+        void disableAutoSave() noexcept;
         /**
          * @brief Serializes the object to Json.
          * @return The Json representation of the object
@@ -85,6 +154,7 @@ namespace Nickvision::Helpers
         T get(const std::string& key, const T& defaultValue) const noexcept
         {
             std::lock_guard lock{ m_mutex };
+            load();
             if constexpr (std::is_same_v<T, int>)
             {
                 if(!m_json.contains(key) || !m_json[key].is_int64())
@@ -151,15 +221,93 @@ namespace Nickvision::Helpers
         template<SupportedJsonValue T>
         void set(const std::string& key, const T& value) noexcept
         {
-            std::lock_guard lock{ m_mutex };
-            m_json[key] = value;
+            {
+                std::lock_guard lock{ m_mutex };
+                load();
+                m_json[key] = value;
+                m_changedKeys.insert(key);
+                m_generation.fetch_add(1, std::memory_order_release);
+            }
+            markDirty();
+        }
+        /**
+         * @brief Creates a typed, cached handle to a value of the json object.
+         * @brief jsonproperty.h must be included to call this method.
+         * @tparam T The type of the value
+         * @param key The key of the value
+         * @param defaultValue The default value to use if the key is not found or if the value is not of the expected type
+         * @return The property of the value
+         */
+        template<SupportedJsonValue T>
+        JsonProperty<T> property(const std::string& key, const T& defaultValue) noexcept
+        {
+            return JsonProperty<T>{ *this, key, defaultValue };
         }
 
     private:
+        template<SupportedJsonValue T>
+        friend class JsonProperty;
+        /**
+         * @brief Loads the json object from the file, if not already loaded.
+         * @brief m_mutex must be locked by the caller.
+         */
+        void load() const noexcept;
+        /**
+         * @brief Applies the journal to the json object.
+         * @brief m_mutex must be locked by the caller.
+         */
+        void loadJournal() const noexcept;
+        /**
+         * @brief Loads the json object from the snapshot file.
+         * @brief m_mutex must be locked by the caller.
+         * @param source The contents of the json file
+         * @return True if the snapshot was up to date with the json file and loaded, else false
+         */
+        bool loadSnapshot(std::span<const std::byte> source) const noexcept;
+        /**
+         * @brief Writes the snapshot file.
+         * @param source The contents written to the json file
+         * @param json The json object written to the json file
+         */
+        void saveSnapshot(std::string_view source, const boost::json::object& json) const noexcept;
+        /**
+         * @brief Saves the config file to disk.
+         * @param notify Whether to invoke the saved event after a successful save
+         * @return True if saved to disk, else false
+         */
+        bool saveFile(bool notify) noexcept;
+        /**
+         * @brief Marks the json object as having unsaved changes, scheduling an auto save if enabled.
+         */
+        void markDirty() noexcept;
+        /**
+         * @brief Runs the auto save loop.
+         */
+        void autoSave() noexcept;
+        /**
+         * @brief Stops the auto save thread and saves any pending changes.
+         * @param notify Whether to invoke the saved event if pending changes are saved
+         */
+        void stopAutoSave(bool notify) noexcept;
         mutable std::mutex m_mutex;
         std::filesystem::path m_path;
+        std::filesystem::path m_snapshotPath;
+        std::filesystem::path m_journalPath;
         mutable boost::json::object m_json;
+        mutable bool m_loaded;
+        std::atomic<std::uint64_t> m_generation;
+        std::unordered_set<std::string> m_changedKeys;
+        bool m_durableSave;
+        std::uint64_t m_journalCompactSize;
+        mutable std::uint64_t m_journalSize;
         Events::Event<Events::EventArgs> m_saved;
+        std::mutex m_saveMutex;
+        mutable std::mutex m_autoSaveMutex;
+        std::condition_variable m_autoSaveCondition;
+        std::thread m_autoSaveThread;
+        std::chrono::milliseconds m_autoSaveDelay;
+        bool m_dirty;
+        bool m_stopAutoSave;
     };
 }
 
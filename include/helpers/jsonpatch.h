@@ -0,0 +1,50 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * Functions for working with JSON Patch (RFC 6902) documents.
+ */
+
+#ifndef JSONPATCH_H
+#define JSONPATCH_H
+
+#include <string>
+#include <string_view>
+#include <boost/json.hpp>
+
+namespace Nickvision::Helpers::JsonPatch
+{
+    /**
+     * @brief Applies a JSON Patch (RFC 6902) to a json document.
+     * @brief The add, remove, replace, move, copy and test operations are supported.
+     * @brief Operations are applied in order. If an operation fails, the operations before it remain applied to the document.
+     * @param document The document to patch
+     * @param patch The array of operations to apply
+     * @return True if all operations were applied, else false
+     */
+    bool apply(boost::json::value& document, const boost::json::array& patch) noexcept;
+    /**
+     * @brief Escapes a key for use as a token of a JSON Pointer (RFC 6901).
+     * @brief Ex: escape("a/b~c") -> "a~1b~0c"
+     * @param key The key to escape
+     * @return The escaped key
+     */
+    std::string escape(std::string_view key) noexcept;
+}
+
+#endif //JSONPATCH_H
@@ -0,0 +1,155 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A typed, cached handle to a value of a JsonFileBase.
+ */
+
+#ifndef JSONPROPERTY_H
+#define JSONPROPERTY_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include "jsonfilebase.h"
+
+namespace Nickvision::Helpers
+{
+    /**
+     * @brief A typed, cached handle to a value of a JsonFileBase.
+     * @brief The decoded value is cached and only read from the json object again after the file has been changed with set().
+     * @brief Reading a cached value does not lock the JsonFileBase or look up its key.
+     * @brief Strings, arrays and objects are returned as shared immutable references instead of copies.
+     * @brief Properties are created by the JsonFileBase they belong to with JsonFileBase::property(), which decides which of them to expose.
+     * @brief The JsonFileBase must outlive its properties.
+     * @tparam T The type of the value
+     */
+    template<SupportedJsonValue T>
+    class JsonProperty
+    {
+    public:
+        /**
+         * @brief Whether or not the value is stored directly in an atomic (instead of behind a shared reference).
+         */
+        static constexpr bool IsScalar{ std::is_arithmetic_v<T> };
+        /**
+         * @brief The type returned by get().
+         */
+        using value_type = std::conditional_t<IsScalar, T, std::shared_ptr<const T>>;
+        /**
+         * @brief Gets the key of the value.
+         * @return The key of the value
+         */
+        const std::string& getKey() const noexcept
+        {
+            return m_key;
+        }
+        /**
+         * @brief Gets the value.
+         * @return The value
+         */
+        value_type get() const noexcept
+        {
+            if(m_generation.load(std::memory_order_acquire) != m_file.m_generation.load(std::memory_order_acquire))
+            {
+                refresh();
+            }
+            if constexpr (IsScalar)
+            {
+                return m_value.load(std::memory_order_acquire);
+            }
+            else
+            {
+#ifdef __cpp_lib_atomic_shared_ptr
+                return m_value.load(std::memory_order_acquire);
+#else
+                return std::atomic_load_explicit(&m_value, std::memory_order_acquire);
+#endif
+            }
+        }
+        /**
+         * @brief Sets the value.
+         * @brief This invalidates the cached values of all properties of the JsonFileBase.
+         * @param value The new value
+         */
+        void set(const T& value) noexcept
+        {
+            m_file.set(m_key, value);
+        }
+
+    private:
+        friend class JsonFileBase;
+        /**
+         * @brief Constructs a JsonProperty.
+         * @param file The JsonFileBase containing the value
+         * @param key The key of the value
+         * @param defaultValue The default value to use if the key is not found or if the value is not of the expected type
+         */
+        JsonProperty(JsonFileBase& file, const std::string& key, const T& defaultValue) noexcept
+            : m_file{ file },
+            m_key{ key },
+            m_defaultValue{ defaultValue },
+            m_generation{ std::numeric_limits<std::uint64_t>::max() }
+        {
+
+        }
+        /**
+         * @brief Reads the value from the JsonFileBase into the cache.
+         */
+        void refresh() const noexcept
+        {
+            std::lock_guard lock{ m_refreshMutex };
+            //The generation is read before the value, so a change made in between only causes another refresh
+            std::uint64_t generation{ m_file.m_generation.load(std::memory_order_acquire) };
+            if(m_generation.load(std::memory_order_relaxed) == generation)
+            {
+                return;
+            }
+            if constexpr (IsScalar)
+            {
+                m_value.store(m_file.get(m_key, m_defaultValue), std::memory_order_release);
+            }
+            else
+            {
+                std::shared_ptr<const T> value{ std::make_shared<const T>(m_file.get(m_key, m_defaultValue)) };
+#ifdef __cpp_lib_atomic_shared_ptr
+                m_value.store(std::move(value), std::memory_order_release);
+#else
+                std::atomic_store_explicit(&m_value, std::move(value), std::memory_order_release);
+#endif
+            }
+            m_generation.store(generation, std::memory_order_release);
+        }
+        JsonFileBase& m_file;
+        std::string m_key;
+        T m_defaultValue;
+        mutable std::mutex m_refreshMutex;
+        mutable std::atomic<std::uint64_t> m_generation;
+#ifdef __cpp_lib_atomic_shared_ptr
+        mutable std::conditional_t<IsScalar, std::atomic<T>, std::atomic<std::shared_ptr<const T>>> m_value;
+#else
+        mutable std::conditional_t<IsScalar, std::atomic<T>, std::shared_ptr<const T>> m_value;
+#endif
+    };
+}
+
+#endif //JSONPROPERTY_H
@@ -1,8 +1,13 @@
 #ifndef PAIRHASH_H
 #define PAIRHASH_H
 
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
 #include <utility>
-#include "codehelpers.h"
+#include "hashedstring.h"
+#include "hashhelpers.h"
 
 namespace Nickvision::Helpers
 {
@@ -24,7 +29,31 @@ namespace Nickvision::Helpers
         template <class T1, class T2>
         size_t operator()(const std::pair<T1,T2>& p) const noexcept
         {
-            return CodeHelpers::combineHash(std::hash<T1>()(p.first), std::hash<T2>()(p.second));
+            return static_cast<size_t>(HashHelpers::mix(hash(p.first) ^ 0x2d358dccaa6c78a5ull, hash(p.second) ^ 0x8bb84b93962eacc9ull));
+        }
+
+    private:
+        /**
+         * @brief Gets the hash value of an element of a std::pair.
+         * @brief Strings are hashed with HashHelpers::hash64() rather than std::hash, and HashedStrings use their precomputed hash.
+         * @param t The element
+         * @return The hash value of the element
+         */
+        template <class T>
+        static std::uint64_t hash(const T& t) noexcept
+        {
+            if constexpr (std::is_same_v<T, HashedString>)
+            {
+                return t.getHash();
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                return HashHelpers::hash64(std::string_view(t));
+            }
+            else
+            {
+                return std::hash<T>()(t);
+            }
         }
     };
 }
@@ -0,0 +1,123 @@
+/**
+ * @file
+ * @author Nicholas Logozzo <nlogozzo225@gmail.com>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details at
+ * https://www.gnu.org/copyleft/gpl.html
+ *
+ * @section DESCRIPTION
+ *
+ * A builder for efficiently creating strings.
+ */
+
+#ifndef STRINGBUILDER_H
+#define STRINGBUILDER_H
+
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace Nickvision::Helpers
+{
+    /**
+     * @brief A builder for efficiently creating strings.
+     * @brief Appends are written directly into a single growable buffer, avoiding the locale and virtual dispatch overhead of std::stringstream.
+     */
+    class StringBuilder
+    {
+    public:
+        /**
+         * @brief Constructs a StringBuilder.
+         * @param capacity The estimated size of the final string to reserve up front
+         */
+        StringBuilder(size_t capacity = 0) noexcept;
+        /**
+         * @brief Appends a string to the builder.
+         * @param s The string to append
+         * @return this
+         */
+        StringBuilder& append(std::string_view s) noexcept;
+        /**
+         * @brief Appends a character to the builder.
+         * @param c The character to append
+         * @return this
+         */
+        StringBuilder& append(char c) noexcept;
+        /**
+         * @brief Appends a string followed by a new line to the builder.
+         * @param s The string to append
+         * @return this
+         */
+        StringBuilder& appendLine(std::string_view s = {}) noexcept;
+        /**
+         * @brief Appends a formatted string to the builder.
+         * @brief The string is formatted directly into the builder's buffer.
+         * @param format The format string
+         * @param args The arguments to format
+         * @return this
+         */
+        template<typename... Args>
+        StringBuilder& appendFormat(std::format_string<Args...> format, Args&&... args)
+        {
+            std::format_to(std::back_inserter(m_buffer), format, std::forward<Args>(args)...);
+            return *this;
+        }
+        /**
+         * @brief Gets the number of characters in the builder.
+         * @return The number of characters
+         */
+        size_t size() const noexcept;
+        /**
+         * @brief Gets whether or not the builder is empty.
+         * @return True if empty, else false
+         */
+        bool empty() const noexcept;
+        /**
+         * @brief Gets the number of characters the builder can hold without reallocating.
+         * @return The capacity of the builder
+         */
+        size_t capacity() const noexcept;
+        /**
+         * @brief Ensures the builder can hold at least the provided number of characters without reallocating.
+         * @param capacity The number of characters
+         */
+        void reserve(size_t capacity) noexcept;
+        /**
+         * @brief Removes all characters from the builder, keeping its capacity.
+         */
+        void clear() noexcept;
+        /**
+         * @brief Gets a view of the built string.
+         * @brief The view is invalidated by any further modification of the builder.
+         * @return The built string view
+         */
+        std::string_view view() const noexcept;
+        /**
+         * @brief Gets a copy of the built string.
+         * @return The built string
+         */
+        std::string str() const noexcept;
+        /**
+         * @brief Moves the built string out of the builder, leaving it empty.
+         * @return The built string
+         */
+        std::string release() noexcept;
+
+    private:
+        std::string m_buffer;
+    };
+}
+
+#endif //STRINGBUILDER_H
@@ -25,7 +25,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -34,24 +37,70 @@ namespace Nickvision::Helpers::StringHelpers
     template<typename T>
     concept StringImplicitlyConstructible = std::is_constructible_v<T, std::string> && std::is_convertible_v<std::string, T>;
 
+    /**
+     * @brief Compares two strings, ignoring the case of ASCII letters.
+     * @param a The first string
+     * @param b The second string
+     * @return A negative value if a sorts before b, a positive value if a sorts after b, 0 if the strings are equal
+     */
+    int compareIgnoreCase(std::string_view a, std::string_view b) noexcept;
     /**
      * @brief Converts a base64 encoded string into a list of bytes.
      * @param base64 The base64 encoded string
      * @return The bytes list from the base64 encoded string, empty list if error
      */
-    std::vector<std::byte> decode(const std::string& base64) noexcept;
+    std::vector<std::byte> decode(std::string_view base64) noexcept;
+    /**
+     * @brief Converts a base64 encoded string into a buffer of bytes.
+     * @brief Use decodedSize() to determine the required size of the buffer.
+     * @param base64 The base64 encoded string
+     * @param bytes The buffer to write the bytes to
+     * @return The number of bytes written, 0 if error or if the buffer is too small
+     */
+    size_t decode(std::string_view base64, std::span<std::byte> bytes) noexcept;
+    /**
+     * @brief Gets the number of bytes a base64 encoded string decodes to.
+     * @param base64 The base64 encoded string
+     * @return The number of decoded bytes, 0 if the string is not a valid length
+     */
+    size_t decodedSize(std::string_view base64) noexcept;
     /**
      * @brief Converts a list of bytes into a base64 encoded string.
      * @param bytes The list of bytes
      * @return The base64 encoded string of the bytes list
      */
-    std::string encode(const std::vector<std::byte>& bytes) noexcept;
+    std::string encode(std::span<const std::byte> bytes) noexcept;
+    /**
+     * @brief Converts a list of bytes into a base64 encoded buffer of characters.
+     * @brief Use encodedSize() to determine the required size of the buffer.
+     * @param bytes The list of bytes
+     * @param base64 The buffer to write the base64 encoded characters to
+     * @return The number of characters written, 0 if the buffer is too small
+     */
+    size_t encode(std::span<const std::byte> bytes, std::span<char> base64) noexcept;
+    /**
+     * @brief Gets the number of characters a list of bytes encodes to in base64.
+     * @param size The number of bytes
+     * @return The number of base64 characters
+     */
+    constexpr size_t encodedSize(size_t size) noexcept
+    {
+        return 4 * ((size + 2) / 3);
+    }
+    /**
+     * @brief Finds the first occurrence of a substring, ignoring the case of ASCII letters.
+     * @param s The string to search
+     * @param find The substring to find
+     * @param pos The position to start searching at
+     * @return The position of the substring, std::string::npos if not found
+     */
+    size_t findIgnoreCase(std::string_view s, std::string_view find, size_t pos = 0) noexcept;
     /**
      * @brief Gets whether or not the provided string is a valid url
      * @param s The string to check
      * @return True if the string is a valid url, else false
      */
-    bool isValidUrl(const std::string& s) noexcept;
+    bool isValidUrl(std::string_view s) noexcept;
     /**
      * @brief Concatenates the elements of a string list using the specified separator between each element.
      * @param values The list of strings to join
@@ -66,6 +115,11 @@ namespace Nickvision::Helpers::StringHelpers
      * @return The new lowercase string
      */
     std::string lower(std::string s) noexcept;
+    /**
+     * @brief Converts the ASCII letters of a string to lowercase in place.
+     * @param s The string to convert
+     */
+    void lowerInPlace(std::string& s) noexcept;
     /**
      * @brief Generates a new uuid value.
      * @return The uuid value
@@ -108,16 +162,26 @@ namespace Nickvision::Helpers::StringHelpers
     std::string replace(std::string s, char toReplace, char replace) noexcept;
     /**
      * @brief Splits a string based on argument delimiters.
+     * @brief Arguments are separated by whitespace, unless the whitespace is within a pair of single or double quotes.
      * @param s The string to split
      * @return The splits of the argument string
      */
-    std::vector<std::string> splitArgs(std::string s) noexcept;
+    std::vector<std::string> splitArgs(std::string_view s) noexcept;
+    /**
+     * @brief Converts the wstring to a UTF-8 string.
+     * @brief The conversion does not depend on the current locale.
+     * @param s The wstring to convert (UTF-16 on Windows, UTF-32 elsewhere)
+     * @return The string version of the wstring, empty string if the wstring is not valid
+     */
+    std::string str(std::wstring_view s) noexcept;
     /**
-     * @brief Converts the wstring to a string.
-     * @param s The wstring to convert
-     * @return The string version of the wstring
+     * @brief Converts the wstring to a UTF-8 buffer of characters.
+     * @brief The conversion does not depend on the current locale.
+     * @param s The wstring to convert (UTF-16 on Windows, UTF-32 elsewhere)
+     * @param out The buffer to write the UTF-8 characters to (4 characters per wchar_t is always enough)
+     * @return The number of characters written, 0 if the wstring is not valid or if the buffer is too small
      */
-    std::string str(const std::wstring& s) noexcept;
+    size_t str(std::wstring_view s, std::span<char> out) noexcept;
     /**
      * @brief Converts a string to an unsigned int
      * @param s The string to convert
@@ -141,6 +205,19 @@ namespace Nickvision::Helpers::StringHelpers
      * @return The new trimmed string
      */
     std::string trim(const std::string& s, char delimiter) noexcept;
+    /**
+     * @brief Gets a view of a string without its beginning and ending whitespace.
+     * @param s The string to trim
+     * @return The trimmed view of s
+     */
+    std::string_view trimView(std::string_view s) noexcept;
+    /**
+     * @brief Gets a view of a string without the delimiter character at its beginning and end.
+     * @param s The string to trim
+     * @param delimiter The character to trim
+     * @return The trimmed view of s
+     */
+    std::string_view trimView(std::string_view s, char delimiter) noexcept;
     /**
      * @brief Gets a fully uppercase string from the provided string.
      * @param s The string to get uppercase
@@ -148,13 +225,132 @@ namespace Nickvision::Helpers::StringHelpers
      */
     std::string upper(std::string s) noexcept;
     /**
-     * @brief Converts the string to a wstring.
+     * @brief Converts the ASCII letters of a string to uppercase in place.
      * @param s The string to convert
-     * @return The wstring version of the string
      */
-    std::wstring wstr(const std::string& s) noexcept;
+    void upperInPlace(std::string& s) noexcept;
+    /**
+     * @brief Converts the UTF-8 string to a wstring.
+     * @brief The conversion does not depend on the current locale.
+     * @param s The string to convert
+     * @return The wstring version of the string (UTF-16 on Windows, UTF-32 elsewhere), empty wstring if the string is not valid UTF-8
+     */
+    std::wstring wstr(std::string_view s) noexcept;
+    /**
+     * @brief Converts the UTF-8 string to a buffer of wide characters.
+     * @brief The conversion does not depend on the current locale.
+     * @param s The string to convert
+     * @param out The buffer to write the wide characters to (1 wchar_t per character is always enough)
+     * @return The number of wide characters written, 0 if the string is not valid UTF-8 or if the buffer is too small
+     */
+    size_t wstr(std::string_view s, std::span<wchar_t> out) noexcept;
+    /**
+     * @brief A lazy, non-allocating range of the tokens of a string split on a delimiter.
+     * @brief The tokens are views into the original string, which must outlive the SplitView and its iterators.
+     */
+    class SplitView
+    {
+    public:
+        /**
+         * @brief An iterator over the tokens of a SplitView.
+         */
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view*;
+            using reference = const std::string_view&;
+
+            /**
+             * @brief Constructs an end Iterator.
+             */
+            Iterator() noexcept;
+            /**
+             * @brief Constructs an Iterator pointing to the first token of a SplitView.
+             * @param view The SplitView to iterate
+             */
+            Iterator(const SplitView* view) noexcept;
+            /**
+             * @brief Gets the current token.
+             * @return The current token
+             */
+            reference operator*() const noexcept;
+            /**
+             * @brief Gets a pointer to the current token.
+             * @return The pointer to the current token
+             */
+            pointer operator->() const noexcept;
+            /**
+             * @brief Advances to the next token.
+             * @return this
+             */
+            Iterator& operator++() noexcept;
+            /**
+             * @brief Advances to the next token.
+             * @return The iterator before it was advanced
+             */
+            Iterator operator++(int) noexcept;
+            /**
+             * @brief Compares two Iterators for equality.
+             * @param other The other Iterator
+             * @return True if both iterators point to the same token, else false
+             */
+            bool operator==(const Iterator& other) const noexcept;
+
+        private:
+            /**
+             * @brief Moves to the next token that should be included.
+             */
+            void next() noexcept;
+            const SplitView* m_view;
+            size_t m_next;
+            std::string_view m_token;
+        };
+
+        /**
+         * @brief Constructs a SplitView.
+         * @param s The string to split
+         * @param delimiter The delimiter to split the string on (an empty delimiter produces a single token)
+         * @param includeEmpty Whether or not to include empty (or whitespace only) tokens
+         */
+        SplitView(std::string_view s, std::string_view delimiter, bool includeEmpty = true) noexcept;
+        /**
+         * @brief Constructs a SplitView.
+         * @param s The string to split
+         * @param delimiter The delimiter to split the string on
+         * @param includeEmpty Whether or not to include empty (or whitespace only) tokens
+         */
+        SplitView(std::string_view s, char delimiter, bool includeEmpty = true) noexcept;
+        /**
+         * @brief Gets an iterator to the first token.
+         * @return The begin iterator
+         */
+        Iterator begin() const noexcept;
+        /**
+         * @brief Gets an iterator past the last token.
+         * @return The end iterator
+         */
+        Iterator end() const noexcept;
+
+    private:
+        /**
+         * @brief Finds the next delimiter.
+         * @param pos The position to start searching from
+         * @return The position of the delimiter, std::string_view::npos if not found
+         */
+        size_t find(size_t pos) const noexcept;
+        std::string_view m_string;
+        std::string_view m_delimiter;
+        size_t m_delimiterLength;
+        char m_delimiterChar;
+        bool m_includeEmpty;
+    };
+
     /**
      * @brief Splits a string based on a delimiter.
+     * @brief Use SplitView to iterate the tokens without allocating.
      * @tparam T The type of the resulting splits (must be a type that can be implicitly converted to string)
      * @param s The string to split
      * @param delimiter The delimiter to split the string on
@@ -162,30 +358,25 @@ namespace Nickvision::Helpers::StringHelpers
      * @return The splits of the string
      */
     template<StringImplicitlyConstructible T = std::string>
-    std::vector<T> split(const std::string& s, const std::string& delimiter, bool includeEmpty = true) noexcept
+    std::vector<T> split(std::string_view s, std::string_view delimiter, bool includeEmpty = true) noexcept
     {
         std::vector<T> splits;
-        size_t last{ 0 };
-        size_t next{ 0 };
-        while((next = s.find(delimiter, last)) != std::string::npos)
+        for(std::string_view token : SplitView{ s, delimiter, includeEmpty })
         {
-            std::string token{ s.substr(last, next - last) };
-            if(includeEmpty || !trim(token).empty())
+            if constexpr (std::is_constructible_v<T, std::string_view>)
             {
-                splits.push_back(token);
+                splits.emplace_back(token);
+            }
+            else
+            {
+                splits.emplace_back(std::string(token));
             }
-            last = next + delimiter.length();
-
-        }
-        std::string finalToken{ s.substr(last) };
-        if(includeEmpty || !trim(finalToken).empty())
-        {
-            splits.push_back(finalToken);
         }
         return splits;
     }
     /**
      * @brief Splits a string based on a delimiter.
+     * @brief Use SplitView to iterate the tokens without allocating.
      * @tparam T The type of the resulting splits (must be a type that can be implicitly converted to string)
      * @param s The string to split
      * @param delimiter The delimiter to split the string on
@@ -193,9 +384,21 @@ namespace Nickvision::Helpers::StringHelpers
      * @return The splits of the string
      */
     template<StringImplicitlyConstructible T = std::string>
-    std::vector<T> split(const std::string& s, char delimiter, bool includeEmpty = true) noexcept
+    std::vector<T> split(std::string_view s, char delimiter, bool includeEmpty = true) noexcept
     {
-        return split<T>(s, std::string(1, delimiter), includeEmpty);
+        std::vector<T> splits;
+        for(std::string_view token : SplitView{ s, delimiter, includeEmpty })
+        {
+            if constexpr (std::is_constructible_v<T, std::string_view>)
+            {
+                splits.emplace_back(token);
+            }
+            else
+            {
+                splits.emplace_back(std::string(token));
+            }
+        }
+        return splits;
     }
 }
 
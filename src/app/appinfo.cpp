@@ -1,5 +1,7 @@
 #include "app/appinfo.h"
+#include <sstream>
 #include <maddy/parser.h>
+#include "helpers/stringbuilder.h"
 #include "helpers/stringhelpers.h"
 
 using namespace Nickvision::Helpers;
@@ -88,16 +90,16 @@ namespace Nickvision::App
             m_htmlChangelog = "";
             return;
         }
-        std::stringstream markdown;
-        for(const std::string& line : StringHelpers::split(StringHelpers::trim(m_changelog), "\n"))
+        StringBuilder builder{ m_changelog.size() + 1 };
+        for(std::string_view line : StringHelpers::SplitView{ StringHelpers::trimView(m_changelog), '\n' })
         {
             if (line.empty())
             {
                 continue;
             }
-            markdown << StringHelpers::trim(line);
-            markdown << std::endl;
+            builder.appendLine(StringHelpers::trimView(line));
         }
+        std::istringstream markdown{ builder.release() };
         maddy::Parser parser;
         m_htmlChangelog = parser.Parse(markdown);
     }
@@ -1,5 +1,7 @@
 #include "app/windowgeometry.h"
 
+using namespace Nickvision::Helpers;
+
 namespace Nickvision::App
 {
     WindowGeometry::WindowGeometry() noexcept
@@ -32,14 +34,10 @@ namespace Nickvision::App
 
     }
 
-    WindowGeometry::WindowGeometry(boost::json::object json) noexcept
-        : m_width{ json["Width"].is_int64() ? static_cast<long>(json["Width"].as_int64()) : 800 },
-        m_height{ json["Height"].is_int64() ? static_cast<long>(json["Height"].as_int64()) : 600 },
-        m_isMaximized{ json["IsMaximized"].is_bool() ? json["IsMaximized"].as_bool() : false },
-        m_x{ json["X"].is_int64() ? static_cast<long>(json["X"].as_int64()) : 10 },
-        m_y{ json["Y"].is_int64() ? static_cast<long>(json["Y"].as_int64()) : 10 }
+    WindowGeometry::WindowGeometry(const boost::json::object& json) noexcept
+        : WindowGeometry{}
     {
-
+        JsonFields::fromObject(json, *this, getJsonFields());
     }
 
     long WindowGeometry::getWidth() const noexcept
@@ -94,12 +92,11 @@ namespace Nickvision::App
 
     boost::json::value WindowGeometry::toJson() const noexcept
     {
-        boost::json::object json;
-        json["Width"] = m_width;
-        json["Height"] = m_height;
-        json["IsMaximized"] = m_isMaximized;
-        json["X"] = m_x;
-        json["Y"] = m_y;
-        return json;
+        return JsonFields::toObject(*this, getJsonFields());
+    }
+
+    std::string WindowGeometry::toJsonString() const noexcept
+    {
+        return JsonFields::toString(*this, getJsonFields());
     }
 }
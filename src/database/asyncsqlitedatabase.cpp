@@ -0,0 +1,206 @@
+#include "database/asyncsqlitedatabase.h"
+#include <stdexcept>
+
+#define MAX_WRITE_BATCH 256
+
+namespace Nickvision::Database
+{
+    AsyncSqliteDatabase::AsyncSqliteDatabase(const std::filesystem::path& path, int flags)
+        : m_database{ path, flags },
+        m_stopping{ false },
+        m_lastTaskId{ 0 },
+        m_interruptibleTaskId{ 0 }
+    {
+        m_thread = std::thread(&AsyncSqliteDatabase::runQueue, this);
+    }
+
+    AsyncSqliteDatabase::~AsyncSqliteDatabase() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_stopping = true;
+        }
+        m_condition.notify_one();
+        if(m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    const std::filesystem::path& AsyncSqliteDatabase::getPath() const noexcept
+    {
+        return m_database.getPath();
+    }
+
+    std::future<bool> AsyncSqliteDatabase::execute(const std::string& command)
+    {
+        return write([command](SqliteDatabase& database)
+        {
+            return database.execute(command);
+        });
+    }
+
+    void AsyncSqliteDatabase::runQueue() noexcept
+    {
+        while(true)
+        {
+            std::vector<Task> batch;
+            {
+                std::unique_lock<std::mutex> lock{ m_mutex };
+                m_condition.wait(lock, [this]()
+                {
+                    return m_stopping || !m_tasks.empty();
+                });
+                if(m_tasks.empty())
+                {
+                    return;
+                }
+                batch.push_back(std::move(m_tasks.front()));
+                m_tasks.pop_front();
+                //A write that can be cancelled runs in its own transaction, as an interrupt rolls back the whole transaction
+                while(batch.front().isWrite && !batch.front().token && !m_tasks.empty() && m_tasks.front().isWrite && !m_tasks.front().token && batch.size() < MAX_WRITE_BATCH)
+                {
+                    batch.push_back(std::move(m_tasks.front()));
+                    m_tasks.pop_front();
+                }
+            }
+            if(batch.front().isWrite)
+            {
+                runWrites(batch);
+            }
+            else if(runTask(batch.front()))
+            {
+                batch.front().complete();
+            }
+        }
+    }
+
+    bool AsyncSqliteDatabase::runTask(Task& task) noexcept
+    {
+        if(task.token)
+        {
+            std::uint64_t id;
+            {
+                std::lock_guard<std::mutex> lock{ m_interruptMutex };
+                id = ++m_lastTaskId;
+                m_interruptibleTaskId = id;
+            }
+            //A cancel callback that runs after the task finished must not interrupt the next task
+            task.token->setCancelFunction([this, id]()
+            {
+                std::lock_guard<std::mutex> lock{ m_interruptMutex };
+                if(m_interruptibleTaskId == id)
+                {
+                    m_database.interrupt();
+                }
+            });
+            //Checked after setting the cancel function, so a token cancelled in between is not missed
+            if(task.token->isCancelled())
+            {
+                disarmTask(task);
+                task.fail(std::make_exception_ptr(std::runtime_error("The task was cancelled.")));
+                return false;
+            }
+        }
+        std::exception_ptr exception;
+        try
+        {
+            task.run(m_database);
+        }
+        catch(...)
+        {
+            exception = std::current_exception();
+        }
+        if(task.token)
+        {
+            disarmTask(task);
+            if(!exception && task.token->isCancelled())
+            {
+                exception = std::make_exception_ptr(std::runtime_error("The task was cancelled."));
+            }
+        }
+        if(exception)
+        {
+            task.fail(exception);
+            return false;
+        }
+        return true;
+    }
+
+    void AsyncSqliteDatabase::disarmTask(Task& task) noexcept
+    {
+        {
+            //Waits for a running cancel callback of the task to finish
+            std::lock_guard<std::mutex> lock{ m_interruptMutex };
+            m_interruptibleTaskId = 0;
+        }
+        task.token->setCancelFunction({});
+    }
+
+    void AsyncSqliteDatabase::runWrites(std::vector<Task>& tasks) noexcept
+    {
+        std::optional<SqliteTransaction> transaction;
+        try
+        {
+            transaction.emplace(m_database, SqliteTransactionType::Immediate);
+        }
+        catch(...)
+        {
+            for(Task& task : tasks)
+            {
+                task.fail(std::current_exception());
+            }
+            return;
+        }
+        std::vector<Task*> succeeded;
+        succeeded.reserve(tasks.size());
+        size_t i{ 0 };
+        for(; i < tasks.size(); i++)
+        {
+            Task& task{ tasks[i] };
+            std::optional<SqliteSavepoint> savepoint;
+            try
+            {
+                savepoint.emplace(m_database);
+            }
+            catch(...)
+            {
+                task.fail(std::current_exception());
+                break;
+            }
+            //A failed task's savepoint is rolled back when it is destroyed, undoing only that task's changes
+            if(!runTask(task))
+            {
+                break;
+            }
+            if(!savepoint->release())
+            {
+                task.fail(std::make_exception_ptr(std::runtime_error("Unable to release the task's savepoint.")));
+                break;
+            }
+            succeeded.push_back(&task);
+        }
+        //Some errors (such as an interrupt) make sqlite roll back the whole transaction, so the batch ends at a failed task and the remaining tasks are run in a new batch
+        if(i < tasks.size())
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            for(size_t j = tasks.size() - 1; j > i; j--)
+            {
+                m_tasks.push_front(std::move(tasks[j]));
+            }
+        }
+        if(!transaction->commit())
+        {
+            transaction.reset();
+            for(Task* task : succeeded)
+            {
+                task->fail(std::make_exception_ptr(std::runtime_error("Unable to commit the write transaction.")));
+            }
+            return;
+        }
+        for(Task* task : succeeded)
+        {
+            task->complete();
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#include "database/sqlitebackupprogresschangedeventargs.h"
+
+namespace Nickvision::Database
+{
+    SqliteBackupProgressChangedEventArgs::SqliteBackupProgressChangedEventArgs(int remainingPages, int totalPages) noexcept
+        : m_remainingPages{ remainingPages },
+        m_totalPages{ totalPages }
+    {
+
+    }
+
+    int SqliteBackupProgressChangedEventArgs::getRemainingPages() const noexcept
+    {
+        return m_remainingPages;
+    }
+
+    int SqliteBackupProgressChangedEventArgs::getTotalPages() const noexcept
+    {
+        return m_totalPages;
+    }
+
+    double SqliteBackupProgressChangedEventArgs::getProgress() const noexcept
+    {
+        if(m_totalPages <= 0)
+        {
+            return 1.0;
+        }
+        return static_cast<double>(m_totalPages - m_remainingPages) / static_cast<double>(m_totalPages);
+    }
+}
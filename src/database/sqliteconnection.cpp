@@ -0,0 +1,71 @@
+#include "database/sqliteconnection.h"
+#include "database/sqliteconnectionpool.h"
+
+namespace Nickvision::Database
+{
+    SqliteConnection::SqliteConnection(SqliteConnectionPool* pool, size_t index, SqliteDatabase* database) noexcept
+        : m_pool{ pool },
+        m_index{ index },
+        m_database{ database }
+    {
+
+    }
+
+    SqliteConnection::SqliteConnection(SqliteConnection&& other) noexcept
+        : m_pool{ other.m_pool },
+        m_index{ other.m_index },
+        m_database{ other.m_database }
+    {
+        other.m_pool = nullptr;
+        other.m_database = nullptr;
+    }
+
+    SqliteConnection::~SqliteConnection() noexcept
+    {
+        release();
+    }
+
+    bool SqliteConnection::isReadOnly() const noexcept
+    {
+        return m_database && m_index != 0;
+    }
+
+    SqliteConnection& SqliteConnection::operator=(SqliteConnection&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            m_pool = other.m_pool;
+            m_index = other.m_index;
+            m_database = other.m_database;
+            other.m_pool = nullptr;
+            other.m_database = nullptr;
+        }
+        return *this;
+    }
+
+    SqliteDatabase& SqliteConnection::operator*() const noexcept
+    {
+        return *m_database;
+    }
+
+    SqliteDatabase* SqliteConnection::operator->() const noexcept
+    {
+        return m_database;
+    }
+
+    SqliteConnection::operator bool() const noexcept
+    {
+        return m_database;
+    }
+
+    void SqliteConnection::release() noexcept
+    {
+        if(m_pool)
+        {
+            m_pool->release(m_index);
+        }
+        m_pool = nullptr;
+        m_database = nullptr;
+    }
+}
@@ -0,0 +1,249 @@
+#include "database/sqliteconnectionpool.h"
+#include <stdexcept>
+
+#define WRITER_INDEX 0
+#define DEFAULT_MMAP_SIZE 268435456
+#define DEFAULT_CACHE_SIZE 8192
+#define BUSY_TIMEOUT 5000
+
+namespace Nickvision::Database
+{
+    SqliteConnectionPool::SqliteConnectionPool(const std::filesystem::path& path, size_t readers)
+        : m_path{ path },
+        m_settingsVersion{ 1 },
+        m_synchronous{ SqliteSynchronous::Normal },
+        m_mmapSize{ DEFAULT_MMAP_SIZE },
+        m_cacheSize{ DEFAULT_CACHE_SIZE }
+    {
+        if(readers == 0)
+        {
+            throw std::invalid_argument("A connection pool requires at least one reader.");
+        }
+        m_connections.reserve(readers + 1);
+        //The writer is opened first, so the read-only connections never have to create the database file
+        m_connections.emplace_back(m_path);
+        for(size_t i = 0; i < readers; i++)
+        {
+            m_connections.emplace_back(m_path, SQLITE_OPEN_READONLY);
+        }
+        m_inUse.resize(m_connections.size(), false);
+        m_configuredVersions.resize(m_connections.size(), 0);
+        m_registeredFunctions.resize(m_connections.size(), 0);
+        configure(WRITER_INDEX);
+    }
+
+    const std::filesystem::path& SqliteConnectionPool::getPath() const noexcept
+    {
+        return m_path;
+    }
+
+    size_t SqliteConnectionPool::getReaderCount() const noexcept
+    {
+        return m_connections.size() - 1;
+    }
+
+    bool SqliteConnectionPool::isEncrypted() const noexcept
+    {
+        return m_connections[WRITER_INDEX].isEncrypted();
+    }
+
+    bool SqliteConnectionPool::isUnlocked() const noexcept
+    {
+        return m_connections[WRITER_INDEX].isUnlocked();
+    }
+
+    bool SqliteConnectionPool::unlock(const std::string& password) noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        bool unlocked{ true };
+        for(SqliteDatabase& connection : m_connections)
+        {
+            unlocked = connection.unlock(password) && unlocked;
+        }
+        return unlocked;
+    }
+
+    SqliteSynchronous SqliteConnectionPool::getSynchronous() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_synchronous;
+    }
+
+    void SqliteConnectionPool::setSynchronous(SqliteSynchronous synchronous) noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_synchronous = synchronous;
+        m_settingsVersion++;
+    }
+
+    std::int64_t SqliteConnectionPool::getMmapSize() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_mmapSize;
+    }
+
+    void SqliteConnectionPool::setMmapSize(std::int64_t size) noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_mmapSize = size;
+        m_settingsVersion++;
+    }
+
+    std::int64_t SqliteConnectionPool::getCacheSize() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_cacheSize;
+    }
+
+    void SqliteConnectionPool::setCacheSize(std::int64_t size) noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_cacheSize = size;
+        m_settingsVersion++;
+    }
+
+    bool SqliteConnectionPool::registerFunction(const std::string& name, const SqliteCustomFunction& func, int expectedArgs, SqliteFunctionFlags flags) noexcept
+    {
+        if(!func)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        try
+        {
+            m_functions.push_back([name, func, expectedArgs, flags](SqliteDatabase& connection)
+            {
+                return connection.registerFunction(name, func, expectedArgs, flags);
+            });
+        }
+        catch(...)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    bool SqliteConnectionPool::registerAggregateFunction(const std::string& name, const SqliteAggregateFunction& func, int expectedArgs, SqliteFunctionFlags flags) noexcept
+    {
+        //Checked here, as SqliteDatabase::registerAggregateFunction() would reject these callbacks on every connection
+        if(!func.step || !func.final || static_cast<bool>(func.value) != static_cast<bool>(func.inverse))
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        try
+        {
+            m_functions.push_back([name, func, expectedArgs, flags](SqliteDatabase& connection)
+            {
+                return connection.registerAggregateFunction(name, func, expectedArgs, flags);
+            });
+        }
+        catch(...)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    SqliteConnection SqliteConnectionPool::getReader() noexcept
+    {
+        return acquire(WRITER_INDEX + 1, m_connections.size());
+    }
+
+    SqliteConnection SqliteConnectionPool::getWriter() noexcept
+    {
+        return acquire(WRITER_INDEX, WRITER_INDEX + 1);
+    }
+
+    SqliteConnection SqliteConnectionPool::acquire(size_t first, size_t last) noexcept
+    {
+        size_t index{ last };
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_released.wait(lock, [&]()
+            {
+                for(size_t i = first; i < last; i++)
+                {
+                    if(!m_inUse[i])
+                    {
+                        index = i;
+                        return true;
+                    }
+                }
+                return false;
+            });
+            m_inUse[index] = true;
+        }
+        configure(index);
+        return { this, index, &m_connections[index] };
+    }
+
+    void SqliteConnectionPool::release(size_t index) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_inUse[index] = false;
+        }
+        m_released.notify_all();
+    }
+
+    void SqliteConnectionPool::configure(size_t index) noexcept
+    {
+        SqliteDatabase& connection{ m_connections[index] };
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        //Pragmas cannot be applied until an encrypted database is unlocked, so the connection stays unconfigured until then
+        if(!connection.isUnlocked())
+        {
+            return;
+        }
+        if(m_configuredVersions[index] == m_settingsVersion && m_registeredFunctions[index] == m_functions.size())
+        {
+            return;
+        }
+        std::uint64_t version{ m_settingsVersion };
+        size_t registered{ m_registeredFunctions[index] };
+        std::string pragmas;
+        std::vector<std::function<bool(SqliteDatabase&)>> functions;
+        try
+        {
+            pragmas = "PRAGMA busy_timeout = " + std::to_string(BUSY_TIMEOUT) + ";";
+            pragmas += "PRAGMA synchronous = " + std::to_string(static_cast<int>(m_synchronous)) + ";";
+            pragmas += "PRAGMA mmap_size = " + std::to_string(m_mmapSize) + ";";
+            pragmas += "PRAGMA cache_size = " + std::to_string(-m_cacheSize) + ";";
+            functions.assign(m_functions.begin() + static_cast<std::ptrdiff_t>(registered), m_functions.end());
+        }
+        catch(...)
+        {
+            //Out of memory, so the connection is configured the next time it is handed out
+            return;
+        }
+        lock.unlock();
+        //The WAL journal mode is persistent in the database file, so only the writer has to set it
+        bool configured{ true };
+        if(index == WRITER_INDEX)
+        {
+            configured = connection.execute("PRAGMA journal_mode = WAL;");
+        }
+        configured = connection.execute(pragmas) && configured;
+        //Only the functions before the first failure are counted, so a failed function (and any after it) is registered again the next time the connection is handed out
+        size_t succeeded{ 0 };
+        bool failed{ false };
+        for(const std::function<bool(SqliteDatabase&)>& function : functions)
+        {
+            if(function(connection) && !failed)
+            {
+                succeeded++;
+            }
+            else
+            {
+                failed = true;
+            }
+        }
+        lock.lock();
+        if(configured)
+        {
+            m_configuredVersions[index] = version;
+        }
+        m_registeredFunctions[index] = registered + succeeded;
+    }
+}
@@ -1,19 +1,65 @@
 #include "database/sqlitedatabase.h"
 #include <stdexcept>
 
+#define DEFAULT_STATEMENT_CACHE_CAPACITY 32
+#define BACKUP_PAGES_PER_STEP 256
+#define BACKUP_BUSY_DELAY 10
+
+using namespace Nickvision::Events;
+using namespace Nickvision::Helpers;
+
 namespace Nickvision::Database
 {
+    static int getTextRepresentation(SqliteFunctionFlags flags) noexcept
+    {
+        int representation{ SQLITE_UTF8 };
+        if((flags & SqliteFunctionFlags::Deterministic) == SqliteFunctionFlags::Deterministic)
+        {
+            representation |= SQLITE_DETERMINISTIC;
+        }
+        if((flags & SqliteFunctionFlags::Innocuous) == SqliteFunctionFlags::Innocuous)
+        {
+            representation |= SQLITE_INNOCUOUS;
+        }
+        if((flags & SqliteFunctionFlags::DirectOnly) == SqliteFunctionFlags::DirectOnly)
+        {
+            representation |= SQLITE_DIRECTONLY;
+        }
+        return representation;
+    }
+
+    static void callFunction(const SqliteCustomFunction& func, SqliteFunctionContext& context) noexcept
+    {
+        //Exceptions must not propagate through sqlite's C stack frames
+        try
+        {
+            func(context);
+        }
+        catch(const std::exception& e)
+        {
+            context.error(e.what());
+        }
+        catch(...)
+        {
+            context.error("Unknown error in custom function.");
+        }
+    }
+
     SqliteDatabase::SqliteDatabase(const std::filesystem::path& path, int flags)
         : m_path{ path },
         m_flags{ flags },
         m_isEncrypted{ false },
         m_isUnlocked{ true },
-        m_database{ nullptr }
+        m_database{ nullptr },
+        m_runningBackups{ 0 },
+        m_transactionMutex{ std::make_shared<std::recursive_mutex>() },
+        m_statementCache{ std::make_shared<SqliteStatementCache>(DEFAULT_STATEMENT_CACHE_CAPACITY) }
     {
         if(sqlite3_open_v2(m_path.string().c_str(), &m_database, m_flags, nullptr) != SQLITE_OK)
         {
             throw std::runtime_error("Unable to open sql database.");
         }
+        m_statementCache->setDatabase(m_database);
         if(sqlite3_exec(m_database, "SELECT count(*) FROM sqlite_master;", nullptr, nullptr, nullptr) != SQLITE_OK)
         {
             m_isEncrypted = true;
@@ -25,21 +71,36 @@ namespace Nickvision::Database
     {
         std::lock_guard<std::mutex> lock{ other.m_mutex };
         m_path = std::move(other.m_path);
+        m_flags = other.m_flags;
         m_isEncrypted = std::move(other.m_isEncrypted);
         m_isUnlocked = std::move(other.m_isUnlocked);
         m_database = other.m_database;
         other.m_database = nullptr;
+        m_runningBackups = 0;
         m_customFunctions = std::move(other.m_customFunctions);
+        m_aggregateFunctions = std::move(other.m_aggregateFunctions);
+        m_backupProgressChanged = std::move(other.m_backupProgressChanged);
+        m_transactionMutex = std::move(other.m_transactionMutex);
+        m_statementCache = std::move(other.m_statementCache);
     }
 
     SqliteDatabase::~SqliteDatabase() noexcept
     {
+        if(m_statementCache)
+        {
+            m_statementCache->setDatabase(nullptr);
+        }
         if (m_database)
         {
             sqlite3_close(m_database);
         }
     }
 
+    Event<SqliteBackupProgressChangedEventArgs>& SqliteDatabase::backupProgressChanged() noexcept
+    {
+        return m_backupProgressChanged;
+    }
+
     const std::filesystem::path& SqliteDatabase::getPath() const noexcept
     {
         return m_path;
@@ -67,6 +128,7 @@ namespace Nickvision::Database
 
     bool SqliteDatabase::unlock(const std::string& password) noexcept
     {
+        std::unique_lock<std::recursive_mutex> transactionLock{ lockTransactions() };
         std::lock_guard<std::mutex> lock{ m_mutex };
         if(!m_database)
         {
@@ -89,8 +151,10 @@ namespace Nickvision::Database
 
     bool SqliteDatabase::setPassword(const std::string& password)
     {
+        std::unique_lock<std::recursive_mutex> transactionLock{ lockTransactions() };
         std::lock_guard<std::mutex> lock{ m_mutex };
-        if(!m_database)
+        //The file of a running backup cannot be replaced or rekeyed
+        if(!m_database || m_runningBackups > 0)
         {
             return false;
         }
@@ -123,27 +187,9 @@ namespace Nickvision::Database
                     }
                 }
             }
-            //Create temp encrypted database
-            std::filesystem::path tempPath{ (m_path.string() + ".encrypt") };
-            std::string cmd{ "ATTACH DATABASE '" + tempPath.string() + "' AS encrypted KEY '" + password + "';" };
-            sqlite3_exec(m_database, cmd.c_str(), nullptr, nullptr, nullptr);
-            sqlite3_exec(m_database, "SELECT sqlcipher_export('encrypted');", nullptr, nullptr, nullptr);
-            sqlite3_exec(m_database, "DETACH DATABASE encrypted;", nullptr, nullptr, nullptr);
-            //Remove old encrypted database
-            if(sqlite3_close(m_database) != SQLITE_OK)
-            {
-                throw std::runtime_error("Unable to close old sql database.");
-            }
-            std::filesystem::remove(m_path);
-            std::filesystem::rename(tempPath, m_path);
-            //Open new encrypted database
-            if (sqlite3_open_v2(m_path.string().c_str(), &m_database, m_flags, nullptr) != SQLITE_OK)
-            {
-                throw std::runtime_error("Unable to open sql database.");
-            }
-            if(sqlite3_key(m_database, password.c_str(), static_cast<int>(password.size())) != SQLITE_OK)
+            if(!replaceWithExport(password))
             {
-                throw std::runtime_error("Unable to open sql database with password.");
+                return false;
             }
             m_isUnlocked = sqlite3_exec(m_database, "SELECT count(*) FROM sqlite_master;", nullptr, nullptr, nullptr) == SQLITE_OK;
             m_isEncrypted = true;
@@ -157,56 +203,201 @@ namespace Nickvision::Database
         //Remove encryption
         if(password.empty())
         {
-            //Create temporary decrypted database
-            std::filesystem::path tempPath{ (m_path.string() + ".decrypt") };
-            std::string cmd{ "ATTACH DATABASE '" + tempPath.string() + "' AS plaintext KEY '';" };
-            sqlite3_exec(m_database, cmd.c_str(), nullptr, nullptr, nullptr);
-            sqlite3_exec(m_database, "SELECT sqlcipher_export('plaintext');", nullptr, nullptr, nullptr);
-            sqlite3_exec(m_database, "DETACH DATABASE plaintext;", nullptr, nullptr, nullptr);
-            //Remove old encrypted database
-            if(sqlite3_close(m_database) != SQLITE_OK)
-            {
-                throw std::runtime_error("Unable to close old sql database.");
-            }
-            std::filesystem::remove(m_path);
-            std::filesystem::rename(tempPath, m_path);
-            //Open new decrypted database
-            if (sqlite3_open_v2(m_path.string().c_str(), &m_database, m_flags, nullptr) != SQLITE_OK)
+            if(!replaceWithExport(""))
             {
-                throw std::runtime_error("Unable to open sql database.");
+                return false;
             }
             m_isEncrypted = false;
             m_isUnlocked = true;
             return true;
         }
         //Reencrypt with new password
-        sqlite3_rekey(m_database, password.c_str(), static_cast<int>(password.size()));
-        return true;
+        return sqlite3_rekey(m_database, password.c_str(), static_cast<int>(password.size())) == SQLITE_OK;
     }
 
-    bool SqliteDatabase::registerFunction(const std::string& name, const SqliteCustomFunction& func, int expectedArgs) noexcept
+    bool SqliteDatabase::backup(const std::filesystem::path& destination, const std::string& password, const std::shared_ptr<CancellationToken>& token) noexcept
     {
+        std::filesystem::path tempPath{ destination.string() + ".backup" };
+        std::error_code error;
+        std::filesystem::remove(tempPath, error);
+        sqlite3* target{ nullptr };
+        sqlite3_backup* backup{ nullptr };
+        {
+            std::unique_lock<std::recursive_mutex> transactionLock{ lockTransactions() };
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            if(!m_database || !m_isUnlocked)
+            {
+                return false;
+            }
+            if(sqlite3_open_v2(tempPath.string().c_str(), &target, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) == SQLITE_OK && (password.empty() || sqlite3_key(target, password.c_str(), static_cast<int>(password.size())) == SQLITE_OK))
+            {
+                backup = sqlite3_backup_init(target, "main", m_database, "main");
+            }
+            if(backup)
+            {
+                m_runningBackups++;
+            }
+        }
+        if(!backup)
+        {
+            sqlite3_close(target);
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        int result{ SQLITE_OK };
+        bool cancelled{ false };
+        while(result == SQLITE_OK || result == SQLITE_BUSY || result == SQLITE_LOCKED)
+        {
+            if(token && token->isCancelled())
+            {
+                cancelled = true;
+                break;
+            }
+            int remainingPages{ 0 };
+            int totalPages{ 0 };
+            {
+                //The mutexes are only held for each chunk, so the database stays usable while it is backed up
+                std::unique_lock<std::recursive_mutex> transactionLock{ lockTransactions() };
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                result = sqlite3_backup_step(backup, BACKUP_PAGES_PER_STEP);
+                remainingPages = sqlite3_backup_remaining(backup);
+                totalPages = sqlite3_backup_pagecount(backup);
+            }
+            if(result == SQLITE_BUSY || result == SQLITE_LOCKED)
+            {
+                sqlite3_sleep(BACKUP_BUSY_DELAY);
+            }
+            else if(result == SQLITE_OK || result == SQLITE_DONE)
+            {
+                m_backupProgressChanged.invoke({ remainingPages, totalPages });
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            sqlite3_backup_finish(backup);
+            m_runningBackups--;
+        }
+        bool copied{ !cancelled && result == SQLITE_DONE };
+        copied = sqlite3_close(target) == SQLITE_OK && copied;
+        if(copied)
+        {
+            std::filesystem::rename(tempPath, destination, error);
+            copied = !error;
+        }
+        if(!copied)
+        {
+            std::filesystem::remove(tempPath, error);
+        }
+        return copied;
+    }
+
+    bool SqliteDatabase::registerFunction(const std::string& name, const SqliteCustomFunction& func, int expectedArgs, SqliteFunctionFlags flags) noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(!m_database)
+        {
+            return false;
+        }
         m_customFunctions[name] = func;
-        return sqlite3_create_function(m_database, name.c_str(), expectedArgs, SQLITE_UTF8, &m_customFunctions[name], +[](sqlite3_context* ctx, int argc, sqlite3_value** argv)
+        return sqlite3_create_function(m_database, name.c_str(), expectedArgs, getTextRepresentation(flags), &m_customFunctions[name], +[](sqlite3_context* ctx, int argc, sqlite3_value** argv)
         {
             SqliteFunctionContext context{ ctx, argc, argv };
-            SqliteCustomFunction& func{ *(static_cast<SqliteCustomFunction*>(context.getUserData())) };
-            func(context);
+            callFunction(*(static_cast<SqliteCustomFunction*>(context.getUserData())), context);
         }, nullptr, nullptr) == SQLITE_OK;
     }
 
+    bool SqliteDatabase::registerAggregateFunction(const std::string& name, const SqliteAggregateFunction& func, int expectedArgs, SqliteFunctionFlags flags) noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(!m_database || !func.step || !func.final || static_cast<bool>(func.value) != static_cast<bool>(func.inverse))
+        {
+            return false;
+        }
+        m_aggregateFunctions[name] = func;
+        using Callback = void(*)(sqlite3_context*, int, sqlite3_value**);
+        using FinalCallback = void(*)(sqlite3_context*);
+        Callback step{ +[](sqlite3_context* ctx, int argc, sqlite3_value** argv)
+        {
+            SqliteFunctionContext context{ ctx, argc, argv };
+            callFunction(static_cast<SqliteAggregateFunction*>(context.getUserData())->step, context);
+        } };
+        FinalCallback final{ +[](sqlite3_context* ctx)
+        {
+            SqliteFunctionContext context{ ctx, 0, nullptr };
+            callFunction(static_cast<SqliteAggregateFunction*>(context.getUserData())->final, context);
+            context.destroyState();
+        } };
+        FinalCallback value{ nullptr };
+        Callback inverse{ nullptr };
+        if(func.value)
+        {
+            value = +[](sqlite3_context* ctx)
+            {
+                SqliteFunctionContext context{ ctx, 0, nullptr };
+                callFunction(static_cast<SqliteAggregateFunction*>(context.getUserData())->value, context);
+            };
+            inverse = +[](sqlite3_context* ctx, int argc, sqlite3_value** argv)
+            {
+                SqliteFunctionContext context{ ctx, argc, argv };
+                callFunction(static_cast<SqliteAggregateFunction*>(context.getUserData())->inverse, context);
+            };
+        }
+        return sqlite3_create_window_function(m_database, name.c_str(), expectedArgs, getTextRepresentation(flags), &m_aggregateFunctions[name], step, final, value, inverse, nullptr) == SQLITE_OK;
+    }
+
+    size_t SqliteDatabase::getStatementCacheCapacity() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_statementCache ? m_statementCache->getCapacity() : 0;
+    }
+
+    void SqliteDatabase::setStatementCacheCapacity(size_t capacity) noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if(m_statementCache)
+        {
+            m_statementCache->setCapacity(capacity);
+        }
+    }
+
+    size_t SqliteDatabase::getStatementCacheHits() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_statementCache ? m_statementCache->getHits() : 0;
+    }
+
+    size_t SqliteDatabase::getStatementCacheMisses() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_statementCache ? m_statementCache->getMisses() : 0;
+    }
+
     SqliteStatement SqliteDatabase::createStatement(const std::string& command)
     {
+        std::unique_lock<std::recursive_mutex> transactionLock{ lockTransactions() };
         std::lock_guard<std::mutex> lock{ m_mutex };
         if (!m_database || !m_isUnlocked)
         {
             return { nullptr, "" };
         }
-        return { m_database, command };
+        std::string key;
+        sqlite3_stmt* statement{ m_statementCache->acquire(command, key) };
+        if(!statement)
+        {
+            key = command;
+            //Statements that will be cached are prepared as long-lived, so sqlite allocates them outside of its lookaside memory
+            unsigned int prepareFlags{ m_statementCache->getCapacity() > 0 ? static_cast<unsigned int>(SQLITE_PREPARE_PERSISTENT) : 0u };
+            if(sqlite3_prepare_v3(m_database, command.c_str(), static_cast<int>(command.size()), prepareFlags, &statement, nullptr) != SQLITE_OK)
+            {
+                throw std::runtime_error("Unable to create sql statement.");
+            }
+        }
+        return { statement, m_statementCache, std::move(key), m_transactionMutex };
     }
 
     bool SqliteDatabase::execute(const std::string& command) noexcept
     {
+        std::unique_lock<std::recursive_mutex> transactionLock{ lockTransactions() };
         std::lock_guard<std::mutex> lock{ m_mutex };
         if (!m_database || !m_isUnlocked)
         {
@@ -215,18 +406,89 @@ namespace Nickvision::Database
         return sqlite3_exec(m_database, command.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK;
     }
 
+    bool SqliteDatabase::replaceWithExport(const std::string& password)
+    {
+        std::filesystem::path tempPath{ m_path.string() + (password.empty() ? ".decrypt" : ".encrypt") };
+        std::error_code error;
+        std::filesystem::remove(tempPath, error);
+        //Export into a temporary database, binding the path and password so they cannot break out of the command
+        bool exported{ false };
+        {
+            SqliteStatement attach{ m_database, "ATTACH DATABASE ? AS export KEY ?;" };
+            if(attach.bind(1, tempPath.string()) && attach.bind(2, password) && attach.step() == SqliteStepResult::Done)
+            {
+                exported = sqlite3_exec(m_database, "SELECT sqlcipher_export('export');", nullptr, nullptr, nullptr) == SQLITE_OK;
+                exported = sqlite3_exec(m_database, "DETACH DATABASE export;", nullptr, nullptr, nullptr) == SQLITE_OK && exported;
+            }
+        }
+        if(!exported)
+        {
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        //Replace the old database, which is never removed before the export is complete
+        m_statementCache->setDatabase(nullptr);
+        if(sqlite3_close(m_database) != SQLITE_OK)
+        {
+            m_statementCache->setDatabase(m_database);
+            std::filesystem::remove(tempPath, error);
+            throw std::runtime_error("Unable to close old sql database.");
+        }
+        m_database = nullptr;
+        std::filesystem::rename(tempPath, m_path);
+        if(sqlite3_open_v2(m_path.string().c_str(), &m_database, m_flags, nullptr) != SQLITE_OK)
+        {
+            throw std::runtime_error("Unable to open sql database.");
+        }
+        m_statementCache->setDatabase(m_database);
+        if(!password.empty() && sqlite3_key(m_database, password.c_str(), static_cast<int>(password.size())) != SQLITE_OK)
+        {
+            throw std::runtime_error("Unable to open sql database with password.");
+        }
+        return true;
+    }
+
+    std::unique_lock<std::recursive_mutex> SqliteDatabase::lockTransactions() const noexcept
+    {
+        //A moved from database has no mutex, its methods fail without locking
+        if(!m_transactionMutex)
+        {
+            return {};
+        }
+        return std::unique_lock<std::recursive_mutex>{ *m_transactionMutex };
+    }
+
+    void SqliteDatabase::interrupt() noexcept
+    {
+        //Not locked, as the mutex is held by the command being interrupted
+        if(m_database)
+        {
+            sqlite3_interrupt(m_database);
+        }
+    }
+
     SqliteDatabase& SqliteDatabase::operator=(SqliteDatabase&& other) noexcept
     {
         if (this != &other)
         {
             std::lock_guard<std::mutex> lock{ m_mutex };
             std::lock_guard<std::mutex> lock2{ other.m_mutex };
+            if(m_statementCache)
+            {
+                m_statementCache->setDatabase(nullptr);
+            }
             m_path = std::move(other.m_path);
+            m_flags = other.m_flags;
             m_isEncrypted = std::move(other.m_isEncrypted);
             m_isUnlocked = std::move(other.m_isUnlocked);
             m_database = other.m_database;
             other.m_database = nullptr;
+            m_runningBackups = 0;
             m_customFunctions = std::move(other.m_customFunctions);
+            m_aggregateFunctions = std::move(other.m_aggregateFunctions);
+            m_backupProgressChanged = std::move(other.m_backupProgressChanged);
+            m_transactionMutex = std::move(other.m_transactionMutex);
+            m_statementCache = std::move(other.m_statementCache);
         }
         return *this;
     }
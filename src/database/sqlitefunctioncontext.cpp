@@ -3,20 +3,22 @@
 namespace Nickvision::Database
 {
     SqliteFunctionContext::SqliteFunctionContext(sqlite3_context* ctx, int argc, sqlite3_value** argv) noexcept
-        : m_context{ ctx }
+        : m_context{ ctx },
+        m_argc{ argv ? argc : 0 },
+        m_argv{ argv }
     {
-        m_values.reserve(argc);
-        for(int i = 0; i < argc; i++)
-        {
-            m_values.push_back({ argv[i] });
-        }
+
     }
 
     SqliteFunctionContext::SqliteFunctionContext(SqliteFunctionContext&& other) noexcept
         : m_context{ other.m_context },
+        m_argc{ other.m_argc },
+        m_argv{ other.m_argv },
         m_values{ std::move(other.m_values) }
     {
         other.m_context = nullptr;
+        other.m_argc = 0;
+        other.m_argv = nullptr;
     }
 
     void* SqliteFunctionContext::getUserData() const noexcept
@@ -28,8 +30,30 @@ namespace Nickvision::Database
         return sqlite3_user_data(m_context);
     }
 
+    int SqliteFunctionContext::getArgCount() const noexcept
+    {
+        return m_argc;
+    }
+
+    SqliteValueView SqliteFunctionContext::getArg(int index) const noexcept
+    {
+        if(index < 0 || index >= m_argc)
+        {
+            return {};
+        }
+        return { m_argv[index] };
+    }
+
     const std::vector<SqliteValue>& SqliteFunctionContext::getArgs() const noexcept
     {
+        if(m_values.empty() && m_argc > 0)
+        {
+            m_values.reserve(m_argc);
+            for(int i = 0; i < m_argc; i++)
+            {
+                m_values.push_back({ m_argv[i] });
+            }
+        }
         return m_values;
     }
 
@@ -42,6 +66,20 @@ namespace Nickvision::Database
         sqlite3_result_null(m_context);
     }
 
+    void SqliteFunctionContext::result(const SqliteValueView& value) noexcept
+    {
+        if(!m_context)
+        {
+            return;
+        }
+        if(!value.m_value)
+        {
+            sqlite3_result_null(m_context);
+            return;
+        }
+        sqlite3_result_value(m_context, value.m_value);
+    }
+
     void SqliteFunctionContext::error(const std::string& err) noexcept
     {
         if(!m_context)
@@ -65,9 +103,28 @@ namespace Nickvision::Database
         if (this != &other)
         {
             m_context = other.m_context;
+            m_argc = other.m_argc;
+            m_argv = other.m_argv;
             m_values = std::move(other.m_values);
             other.m_context = nullptr;
+            other.m_argc = 0;
+            other.m_argv = nullptr;
         }
         return *this;
     }
+
+    void SqliteFunctionContext::destroyState() noexcept
+    {
+        if(!m_context)
+        {
+            return;
+        }
+        //A size of 0 gets the existing aggregate context without allocating one
+        AggregateState* state{ static_cast<AggregateState*>(sqlite3_aggregate_context(m_context, 0)) };
+        if(state && state->data)
+        {
+            state->destroy(state->data);
+            state->data = nullptr;
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "database/sqlitesavepoint.h"
+#include <atomic>
+#include <stdexcept>
+#include "database/sqlitedatabase.h"
+
+namespace Nickvision::Database
+{
+    static std::atomic<unsigned long long> s_nextSavepointId{ 0 };
+
+    SqliteSavepoint::SqliteSavepoint(SqliteDatabase& database)
+        : m_database{ database },
+        m_name{ "libnick_savepoint_" + std::to_string(s_nextSavepointId++) },
+        m_lock{ database.lockTransactions() },
+        m_isActive{ false }
+    {
+        if(!m_database.execute("SAVEPOINT " + m_name + ";"))
+        {
+            throw std::runtime_error("Unable to create sql savepoint.");
+        }
+        m_isActive = true;
+    }
+
+    SqliteSavepoint::~SqliteSavepoint() noexcept
+    {
+        rollback();
+    }
+
+    const std::string& SqliteSavepoint::getName() const noexcept
+    {
+        return m_name;
+    }
+
+    bool SqliteSavepoint::isActive() const noexcept
+    {
+        return m_isActive;
+    }
+
+    bool SqliteSavepoint::release() noexcept
+    {
+        if(!m_isActive)
+        {
+            return false;
+        }
+        m_isActive = !m_database.execute("RELEASE " + m_name + ";");
+        if(!m_isActive)
+        {
+            m_lock.unlock();
+        }
+        return !m_isActive;
+    }
+
+    bool SqliteSavepoint::rollback() noexcept
+    {
+        if(!m_isActive)
+        {
+            return false;
+        }
+        m_isActive = false;
+        //ROLLBACK TO keeps the savepoint on the stack, so it is released afterwards
+        bool result{ m_database.execute("ROLLBACK TO " + m_name + ";") && m_database.execute("RELEASE " + m_name + ";") };
+        m_lock.unlock();
+        return result;
+    }
+}
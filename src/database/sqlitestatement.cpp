@@ -12,18 +12,27 @@ namespace Nickvision::Database
         }
     }
 
+    SqliteStatement::SqliteStatement(sqlite3_stmt* statement, const std::shared_ptr<SqliteStatementCache>& cache, std::string&& key, const std::shared_ptr<std::recursive_mutex>& transactionMutex) noexcept
+        : m_statement{ statement },
+        m_cache{ cache },
+        m_key{ std::move(key) },
+        m_transactionMutex{ transactionMutex }
+    {
+
+    }
+
     SqliteStatement::SqliteStatement(SqliteStatement&& other) noexcept
-        : m_statement{ other.m_statement }
+        : m_statement{ other.m_statement },
+        m_cache{ std::move(other.m_cache) },
+        m_key{ std::move(other.m_key) },
+        m_transactionMutex{ std::move(other.m_transactionMutex) }
     {
         other.m_statement = nullptr;
     }
 
     SqliteStatement::~SqliteStatement() noexcept
     {
-        if(m_statement)
-        {
-            sqlite3_finalize(m_statement);
-        }
+        close();
     }
 
     SqliteStepResult SqliteStatement::step() noexcept
@@ -32,7 +41,12 @@ namespace Nickvision::Database
         {
             return SqliteStepResult::Error;
         }
-        int res{ sqlite3_step(m_statement) };
+        int res;
+        {
+            //Waits for another thread's transaction, so the statement does not run within it
+            std::unique_lock<std::recursive_mutex> lock{ lockTransactions() };
+            res = sqlite3_step(m_statement);
+        }
         if(res == SQLITE_ROW)
         {
             return SqliteStepResult::Row;
@@ -48,20 +62,39 @@ namespace Nickvision::Database
     {
         if(m_statement)
         {
+            std::unique_lock<std::recursive_mutex> lock{ lockTransactions() };
             sqlite3_reset(m_statement);
             sqlite3_clear_bindings(m_statement);
         }
     }
 
+    bool SqliteStatement::bindNull(int index) noexcept
+    {
+        if(!m_statement)
+        {
+            return false;
+        }
+        return sqlite3_bind_null(m_statement, index) == SQLITE_OK;
+    }
+
+    bool SqliteStatement::isColumnNull(int index) noexcept
+    {
+        if(!m_statement)
+        {
+            return true;
+        }
+        return sqlite3_column_type(m_statement, index) == SQLITE_NULL;
+    }
+
     SqliteStatement& SqliteStatement::operator=(SqliteStatement&& other) noexcept
     {
         if(this != &other)
         {
-            if(m_statement)
-            {
-                sqlite3_finalize(m_statement);
-            }
+            close();
             m_statement = other.m_statement;
+            m_cache = std::move(other.m_cache);
+            m_key = std::move(other.m_key);
+            m_transactionMutex = std::move(other.m_transactionMutex);
             other.m_statement = nullptr;
         }
         return *this;
@@ -71,4 +104,32 @@ namespace Nickvision::Database
     {
         return m_statement != nullptr;
     }
+
+    std::unique_lock<std::recursive_mutex> SqliteStatement::lockTransactions() const noexcept
+    {
+        if(!m_transactionMutex)
+        {
+            return {};
+        }
+        return std::unique_lock<std::recursive_mutex>{ *m_transactionMutex };
+    }
+
+    void SqliteStatement::close() noexcept
+    {
+        if(!m_statement)
+        {
+            return;
+        }
+        //Returning the statement resets it, which must also wait for another thread's transaction
+        std::unique_lock<std::recursive_mutex> lock{ lockTransactions() };
+        if(std::shared_ptr<SqliteStatementCache> cache{ m_cache.lock() })
+        {
+            cache->release(m_statement, std::move(m_key));
+        }
+        else
+        {
+            sqlite3_finalize(m_statement);
+        }
+        m_statement = nullptr;
+    }
 }
\ No newline at end of file
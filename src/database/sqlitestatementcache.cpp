@@ -0,0 +1,135 @@
+#include "database/sqlitestatementcache.h"
+
+namespace Nickvision::Database
+{
+    SqliteStatementCache::SqliteStatementCache(size_t capacity) noexcept
+        : m_capacity{ capacity },
+        m_database{ nullptr },
+        m_hits{ 0 },
+        m_misses{ 0 }
+    {
+
+    }
+
+    SqliteStatementCache::~SqliteStatementCache() noexcept
+    {
+        clear();
+    }
+
+    size_t SqliteStatementCache::getCapacity() const noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        return m_capacity;
+    }
+
+    void SqliteStatementCache::setCapacity(size_t capacity) noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        m_capacity = capacity;
+        evict();
+    }
+
+    size_t SqliteStatementCache::size() const noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        return m_statements.size();
+    }
+
+    size_t SqliteStatementCache::getHits() const noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        return m_hits;
+    }
+
+    size_t SqliteStatementCache::getMisses() const noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        return m_misses;
+    }
+
+    void SqliteStatementCache::setDatabase(sqlite3* database) noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        finalizeAll();
+        m_database = database;
+    }
+
+    sqlite3_stmt* SqliteStatementCache::acquire(std::string_view command, std::string& key) noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        std::unordered_map<std::string_view, std::list<std::pair<std::string, sqlite3_stmt*>>::iterator>::iterator it{ m_index.find(command) };
+        if(it == m_index.end())
+        {
+            m_misses++;
+            return nullptr;
+        }
+        m_hits++;
+        sqlite3_stmt* statement{ it->second->second };
+        std::list<std::pair<std::string, sqlite3_stmt*>>::iterator entry{ it->second };
+        m_index.erase(it);
+        //The key is moved out of the entry, so a hit does not allocate
+        key = std::move(entry->first);
+        m_statements.erase(entry);
+        return statement;
+    }
+
+    void SqliteStatementCache::release(sqlite3_stmt* statement, std::string&& key) noexcept
+    {
+        if(!statement)
+        {
+            return;
+        }
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+        std::unique_lock lock{ m_mutex };
+        //Statements of another connection (such as one closed by a password change) and duplicates of cached statements are not kept
+        if(m_capacity == 0 || key.empty() || sqlite3_db_handle(statement) != m_database || m_index.contains(key))
+        {
+            lock.unlock();
+            sqlite3_finalize(statement);
+            return;
+        }
+        try
+        {
+            m_statements.emplace_front(std::move(key), statement);
+            m_index.emplace(m_statements.front().first, m_statements.begin());
+        }
+        catch(...)
+        {
+            if(!m_statements.empty() && m_statements.front().second == statement)
+            {
+                m_statements.pop_front();
+            }
+            lock.unlock();
+            sqlite3_finalize(statement);
+            return;
+        }
+        evict();
+    }
+
+    void SqliteStatementCache::clear() noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        finalizeAll();
+    }
+
+    void SqliteStatementCache::finalizeAll() noexcept
+    {
+        for(const std::pair<std::string, sqlite3_stmt*>& pair : m_statements)
+        {
+            sqlite3_finalize(pair.second);
+        }
+        m_statements.clear();
+        m_index.clear();
+    }
+
+    void SqliteStatementCache::evict() noexcept
+    {
+        while(m_statements.size() > m_capacity)
+        {
+            m_index.erase(m_statements.back().first);
+            sqlite3_finalize(m_statements.back().second);
+            m_statements.pop_back();
+        }
+    }
+}
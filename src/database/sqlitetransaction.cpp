@@ -0,0 +1,64 @@
+#include "database/sqlitetransaction.h"
+#include <stdexcept>
+#include "database/sqlitedatabase.h"
+
+namespace Nickvision::Database
+{
+    SqliteTransaction::SqliteTransaction(SqliteDatabase& database, SqliteTransactionType type)
+        : m_database{ database },
+        m_lock{ database.lockTransactions() },
+        m_isActive{ false }
+    {
+        const char* command{ "BEGIN DEFERRED;" };
+        if(type == SqliteTransactionType::Immediate)
+        {
+            command = "BEGIN IMMEDIATE;";
+        }
+        else if(type == SqliteTransactionType::Exclusive)
+        {
+            command = "BEGIN EXCLUSIVE;";
+        }
+        if(!m_database.execute(command))
+        {
+            throw std::runtime_error("Unable to begin sql transaction.");
+        }
+        m_isActive = true;
+    }
+
+    SqliteTransaction::~SqliteTransaction() noexcept
+    {
+        rollback();
+    }
+
+    bool SqliteTransaction::isActive() const noexcept
+    {
+        return m_isActive;
+    }
+
+    bool SqliteTransaction::commit() noexcept
+    {
+        if(!m_isActive)
+        {
+            return false;
+        }
+        //A failed commit (such as one blocked by a reader) leaves the transaction active, so it can be retried or rolled back
+        m_isActive = !m_database.execute("COMMIT;");
+        if(!m_isActive)
+        {
+            m_lock.unlock();
+        }
+        return !m_isActive;
+    }
+
+    bool SqliteTransaction::rollback() noexcept
+    {
+        if(!m_isActive)
+        {
+            return false;
+        }
+        m_isActive = false;
+        bool result{ m_database.execute("ROLLBACK;") };
+        m_lock.unlock();
+        return result;
+    }
+}
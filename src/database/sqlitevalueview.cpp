@@ -0,0 +1,21 @@
+#include "database/sqlitevalueview.h"
+
+namespace Nickvision::Database
+{
+    SqliteValueView::SqliteValueView(sqlite3_value* value) noexcept
+        : m_value{ value },
+        m_type{ value ? sqlite3_value_type(value) : SQLITE_NULL }
+    {
+
+    }
+
+    int SqliteValueView::getType() const noexcept
+    {
+        return m_type;
+    }
+
+    bool SqliteValueView::isNull() const noexcept
+    {
+        return m_type == SQLITE_NULL;
+    }
+}
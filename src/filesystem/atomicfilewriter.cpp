@@ -0,0 +1,309 @@
+#include "filesystem/atomicfilewriter.h"
+#include <algorithm>
+#include <cerrno>
+#include <random>
+#include <stdexcept>
+#include <string>
+#ifndef _WIN32
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+#define BUFFER_SIZE (64 * 1024)
+#define MAX_SYMLINK_DEPTH 40
+
+namespace Nickvision::Filesystem
+{
+    /**
+     * @brief Gets a unique temporary path in the same directory as a file.
+     * @brief The temporary file must be on the same file system as the file for the rename to be atomic.
+     * @param path The path of the file
+     * @return The temporary path
+     */
+    static std::filesystem::path getTempPath(const std::filesystem::path& path) noexcept
+    {
+        std::random_device random;
+        unsigned long long id{ (static_cast<unsigned long long>(random()) << 32) | random() };
+        std::filesystem::path temp{ path };
+        temp.replace_filename("." + path.filename().string() + "." + std::to_string(id) + ".tmp");
+        return temp;
+    }
+
+    AtomicFileWriter::AtomicFileWriter(const std::filesystem::path& path, bool durable)
+        : m_path{ path },
+        m_durable{ durable },
+        m_failed{ false },
+#ifdef _WIN32
+        m_file{ INVALID_HANDLE_VALUE }
+#else
+        m_file{ -1 }
+#endif
+    {
+        if(m_path.empty() || !m_path.has_filename())
+        {
+            throw std::runtime_error("Invalid file path.");
+        }
+        //Renaming over a symbolic link would replace the link itself, so the file it points to is written instead
+        std::error_code ec;
+        for(int i = 0; i < MAX_SYMLINK_DEPTH && std::filesystem::is_symlink(m_path, ec); i++)
+        {
+            std::filesystem::path target{ std::filesystem::read_symlink(m_path, ec) };
+            if(ec)
+            {
+                break;
+            }
+            m_path = target.is_absolute() ? target : m_path.parent_path() / target;
+        }
+#ifdef _WIN32
+        for(int i = 0; i < 8 && m_file == INVALID_HANDLE_VALUE; i++)
+        {
+            m_tempPath = getTempPath(m_path);
+            m_file = CreateFileW(m_tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if(m_file == INVALID_HANDLE_VALUE && GetLastError() != ERROR_FILE_EXISTS)
+            {
+                break;
+            }
+        }
+        if(m_file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Unable to create temporary file.");
+        }
+#else
+        //Keep the permissions of the file being replaced
+        struct stat st;
+        bool exists{ stat(m_path.c_str(), &st) == 0 };
+        mode_t mode{ exists ? static_cast<mode_t>(st.st_mode & 07777) : static_cast<mode_t>(0666) };
+        for(int i = 0; i < 8 && m_file == -1; i++)
+        {
+            m_tempPath = getTempPath(m_path);
+            m_file = open(m_tempPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode);
+            if(m_file == -1 && errno != EEXIST)
+            {
+                break;
+            }
+        }
+        if(m_file == -1)
+        {
+            throw std::runtime_error("Unable to create temporary file.");
+        }
+        if(exists)
+        {
+            fchmod(m_file, mode);
+        }
+#endif
+        m_buffer.reserve(BUFFER_SIZE);
+    }
+
+    AtomicFileWriter::~AtomicFileWriter() noexcept
+    {
+        discard();
+    }
+
+    const std::filesystem::path& AtomicFileWriter::getPath() const noexcept
+    {
+        return m_path;
+    }
+
+    bool AtomicFileWriter::write(std::span<const std::byte> bytes) noexcept
+    {
+        if(m_failed || m_tempPath.empty())
+        {
+            return false;
+        }
+        if(m_buffer.size() + bytes.size() > m_buffer.capacity())
+        {
+            if(!flush())
+            {
+                return false;
+            }
+            //Large writes skip the buffer to avoid an extra copy
+            if(bytes.size() >= m_buffer.capacity())
+            {
+                return writeDirect(bytes.data(), bytes.size());
+            }
+        }
+        m_buffer.insert(m_buffer.end(), bytes.begin(), bytes.end());
+        return true;
+    }
+
+    bool AtomicFileWriter::write(std::string_view s) noexcept
+    {
+        return write(std::span<const std::byte>{ reinterpret_cast<const std::byte*>(s.data()), s.size() });
+    }
+
+    bool AtomicFileWriter::write(std::span<const std::span<const std::byte>> buffers) noexcept
+    {
+        if(m_failed || m_tempPath.empty() || !flush())
+        {
+            return false;
+        }
+#ifdef _WIN32
+        for(const std::span<const std::byte>& bytes : buffers)
+        {
+            if(!write(bytes))
+            {
+                return false;
+            }
+        }
+        return true;
+#else
+        std::vector<struct iovec> vectors;
+        vectors.reserve(buffers.size());
+        for(const std::span<const std::byte>& bytes : buffers)
+        {
+            if(!bytes.empty())
+            {
+                vectors.push_back({ const_cast<std::byte*>(bytes.data()), bytes.size() });
+            }
+        }
+        size_t index{ 0 };
+        while(index < vectors.size())
+        {
+            ssize_t written{ writev(m_file, vectors.data() + index, static_cast<int>(std::min<size_t>(vectors.size() - index, IOV_MAX))) };
+            if(written == -1)
+            {
+                if(errno == EINTR)
+                {
+                    continue;
+                }
+                m_failed = true;
+                return false;
+            }
+            //Skip the fully written buffers and advance into a partially written one
+            size_t remaining{ static_cast<size_t>(written) };
+            while(index < vectors.size() && remaining >= vectors[index].iov_len)
+            {
+                remaining -= vectors[index].iov_len;
+                index++;
+            }
+            if(index < vectors.size())
+            {
+                vectors[index].iov_base = static_cast<char*>(vectors[index].iov_base) + remaining;
+                vectors[index].iov_len -= remaining;
+            }
+        }
+        return true;
+#endif
+    }
+
+    bool AtomicFileWriter::commit() noexcept
+    {
+        if(m_failed || m_tempPath.empty() || !flush())
+        {
+            discard();
+            return false;
+        }
+#ifdef _WIN32
+        if(m_durable && !FlushFileBuffers(m_file))
+        {
+            discard();
+            return false;
+        }
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+        if(!MoveFileExW(m_tempPath.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING | (m_durable ? MOVEFILE_WRITE_THROUGH : 0)))
+        {
+            discard();
+            return false;
+        }
+#else
+#ifdef __APPLE__
+        //fsync does not flush the drive's cache on macOS
+        if(m_durable && fcntl(m_file, F_FULLFSYNC) == -1 && fsync(m_file) == -1)
+#else
+        if(m_durable && fdatasync(m_file) == -1)
+#endif
+        {
+            discard();
+            return false;
+        }
+        close(m_file);
+        m_file = -1;
+        if(rename(m_tempPath.c_str(), m_path.c_str()) == -1)
+        {
+            discard();
+            return false;
+        }
+        if(m_durable)
+        {
+            //The rename itself is only durable once the directory is flushed
+            std::filesystem::path directory{ m_path.has_parent_path() ? m_path.parent_path() : "." };
+            int fd{ open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+            if(fd != -1)
+            {
+                fsync(fd);
+                close(fd);
+            }
+        }
+#endif
+        m_tempPath.clear();
+        return true;
+    }
+
+    bool AtomicFileWriter::flush() noexcept
+    {
+        if(m_buffer.empty())
+        {
+            return true;
+        }
+        bool res{ writeDirect(m_buffer.data(), m_buffer.size()) };
+        m_buffer.clear();
+        return res;
+    }
+
+    bool AtomicFileWriter::writeDirect(const std::byte* data, size_t size) noexcept
+    {
+        while(size > 0)
+        {
+#ifdef _WIN32
+            DWORD written;
+            if(!WriteFile(m_file, data, static_cast<DWORD>(std::min<size_t>(size, 1024 * 1024 * 1024)), &written, nullptr))
+            {
+                m_failed = true;
+                return false;
+            }
+#else
+            ssize_t written{ ::write(m_file, data, size) };
+            if(written == -1)
+            {
+                if(errno == EINTR)
+                {
+                    continue;
+                }
+                m_failed = true;
+                return false;
+            }
+#endif
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    void AtomicFileWriter::discard() noexcept
+    {
+#ifdef _WIN32
+        if(m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if(m_file != -1)
+        {
+            close(m_file);
+            m_file = -1;
+        }
+#endif
+        if(!m_tempPath.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_tempPath, ec);
+            m_tempPath.clear();
+        }
+        m_buffer.clear();
+    }
+}
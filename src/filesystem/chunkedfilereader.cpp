@@ -0,0 +1,54 @@
+#include "filesystem/chunkedfilereader.h"
+#include <stdexcept>
+
+namespace Nickvision::Filesystem
+{
+    ChunkedFileReader::ChunkedFileReader(const std::filesystem::path& path, size_t chunkSize)
+        : m_path{ path },
+        m_chunkSize{ chunkSize },
+        m_endOfFile{ false }
+    {
+        if(m_chunkSize == 0)
+        {
+            throw std::invalid_argument("The chunk size must be greater than 0.");
+        }
+        //Reads go straight into the chunk buffer, so the stream does not need its own
+        m_file.rdbuf()->pubsetbuf(nullptr, 0);
+        m_file.open(m_path, std::ios::binary);
+        if(!m_file.is_open())
+        {
+            throw std::runtime_error("Unable to open file.");
+        }
+        m_buffer = std::make_unique_for_overwrite<std::byte[]>(m_chunkSize);
+    }
+
+    const std::filesystem::path& ChunkedFileReader::getPath() const noexcept
+    {
+        return m_path;
+    }
+
+    size_t ChunkedFileReader::getChunkSize() const noexcept
+    {
+        return m_chunkSize;
+    }
+
+    bool ChunkedFileReader::isEndOfFile() const noexcept
+    {
+        return m_endOfFile;
+    }
+
+    std::span<const std::byte> ChunkedFileReader::read() noexcept
+    {
+        if(m_endOfFile)
+        {
+            return {};
+        }
+        m_file.read(reinterpret_cast<char*>(m_buffer.get()), static_cast<std::streamsize>(m_chunkSize));
+        size_t count{ static_cast<size_t>(m_file.gcount()) };
+        if(count < m_chunkSize)
+        {
+            m_endOfFile = true;
+        }
+        return { m_buffer.get(), count };
+    }
+}
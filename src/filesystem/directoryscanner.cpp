@@ -0,0 +1,196 @@
+#include "filesystem/directoryscanner.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#endif
+
+namespace Nickvision::Filesystem
+{
+    /**
+     * @brief Lists the direct children of a directory.
+     * @param directory The directory to list
+     * @param flags The flags of what to collect
+     * @param entries The list to append collected entries to
+     * @param subdirectories The list to append subdirectories to (for recursion)
+     * @param buffer A reusable buffer for directory records
+     */
+    static void listDirectory(const std::filesystem::path& directory, ScanFlags flags, std::vector<std::filesystem::path>& entries, std::vector<std::filesystem::path>& subdirectories, std::vector<char>& buffer) noexcept
+    {
+        bool includeFiles{ (flags & ScanFlags::Files) == ScanFlags::Files };
+        bool includeDirectories{ (flags & ScanFlags::Directories) == ScanFlags::Directories };
+        bool recursive{ (flags & ScanFlags::Recursive) == ScanFlags::Recursive };
+        bool followSymlinks{ (flags & ScanFlags::FollowSymlinks) == ScanFlags::FollowSymlinks };
+#ifdef __linux__
+        //getdents64 returns the type of each entry with the name, so no stat is needed per entry
+        int fd{ open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+        if(fd == -1)
+        {
+            return;
+        }
+        while(true)
+        {
+            long length{ syscall(SYS_getdents64, fd, buffer.data(), buffer.size()) };
+            if(length <= 0)
+            {
+                break;
+            }
+            for(long i = 0; i < length;)
+            {
+                struct dirent64* entry{ reinterpret_cast<struct dirent64*>(buffer.data() + i) };
+                i += entry->d_reclen;
+                const char* name{ entry->d_name };
+                if(name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                {
+                    continue;
+                }
+                bool isDirectory{ entry->d_type == DT_DIR };
+                bool isSymlink{ entry->d_type == DT_LNK };
+                struct stat st;
+                if(entry->d_type == DT_UNKNOWN && fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0)
+                {
+                    isDirectory = S_ISDIR(st.st_mode);
+                    isSymlink = S_ISLNK(st.st_mode);
+                }
+                //Only a symbolic link needs a stat of its target, to tell whether it points to a directory
+                bool isLinkedDirectory{ followSymlinks && isSymlink && fstatat(fd, name, &st, 0) == 0 && S_ISDIR(st.st_mode) };
+                if(isDirectory || isLinkedDirectory)
+                {
+                    //Linked directories are never descended into, so a link cannot create a cycle
+                    if(includeDirectories || (recursive && isDirectory))
+                    {
+                        std::filesystem::path path{ directory / name };
+                        if(recursive && isDirectory)
+                        {
+                            subdirectories.push_back(path);
+                        }
+                        if(includeDirectories)
+                        {
+                            entries.push_back(std::move(path));
+                        }
+                    }
+                }
+                else if(includeFiles)
+                {
+                    entries.push_back(directory / name);
+                }
+            }
+        }
+        close(fd);
+#else
+        //directory_entry caches the type reported by the directory listing, so no stat is needed per entry
+        std::error_code ec;
+        for(std::filesystem::directory_iterator it{ directory, std::filesystem::directory_options::skip_permission_denied, ec }; !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+        {
+            std::error_code typeEc;
+            bool isSymlink{ it->is_symlink(typeEc) };
+            bool isDirectory{ it->is_directory(typeEc) && !isSymlink };
+            bool isLinkedDirectory{ followSymlinks && isSymlink && it->is_directory(typeEc) };
+            if(isDirectory || isLinkedDirectory)
+            {
+                //Linked directories are never descended into, so a link cannot create a cycle
+                if(recursive && isDirectory)
+                {
+                    subdirectories.push_back(it->path());
+                }
+                if(includeDirectories)
+                {
+                    entries.push_back(it->path());
+                }
+            }
+            else if(includeFiles)
+            {
+                entries.push_back(it->path());
+            }
+        }
+        (void)buffer;
+#endif
+    }
+
+    std::vector<std::filesystem::path> DirectoryScanner::scan(const std::filesystem::path& path, ScanFlags flags, unsigned int threads) noexcept
+    {
+        std::vector<std::filesystem::path> entries;
+        std::vector<std::filesystem::path> subdirectories;
+        std::vector<char> buffer(64 * 1024);
+        //Scan the root on the calling thread, only spinning up workers if there is more to do
+        listDirectory(path, flags, entries, subdirectories, buffer);
+        if(subdirectories.empty())
+        {
+            return entries;
+        }
+        if(threads == 0)
+        {
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::filesystem::path> queue{ std::make_move_iterator(subdirectories.begin()), std::make_move_iterator(subdirectories.end()) };
+        size_t active{ 0 };
+        std::vector<std::vector<std::filesystem::path>> results(threads);
+        auto worker{ [&](std::vector<std::filesystem::path>& result)
+        {
+            std::vector<std::filesystem::path> found;
+            std::vector<char> workerBuffer(64 * 1024);
+            std::unique_lock<std::mutex> lock{ mutex };
+            while(true)
+            {
+                cv.wait(lock, [&]() { return !queue.empty() || active == 0; });
+                if(queue.empty())
+                {
+                    break;
+                }
+                std::filesystem::path directory{ std::move(queue.front()) };
+                queue.pop_front();
+                active++;
+                lock.unlock();
+                listDirectory(directory, flags, result, found, workerBuffer);
+                lock.lock();
+                active--;
+                std::move(found.begin(), found.end(), std::back_inserter(queue));
+                if(!found.empty() || (queue.empty() && active == 0))
+                {
+                    cv.notify_all();
+                }
+                found.clear();
+            }
+        } };
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for(unsigned int i = 1; i < threads; i++)
+        {
+            try
+            {
+                pool.emplace_back(worker, std::ref(results[i]));
+            }
+            catch(...)
+            {
+                break;
+            }
+        }
+        worker(results[0]);
+        for(std::thread& thread : pool)
+        {
+            thread.join();
+        }
+        size_t total{ entries.size() };
+        for(const std::vector<std::filesystem::path>& result : results)
+        {
+            total += result.size();
+        }
+        entries.reserve(total);
+        for(std::vector<std::filesystem::path>& result : results)
+        {
+            std::move(result.begin(), result.end(), std::back_inserter(entries));
+        }
+        return entries;
+    }
+}
@@ -2,6 +2,7 @@
 #include <cstdlib>
 #include <algorithm>
 #include <stdexcept>
+#include "filesystem/directoryscanner.h"
 #ifdef __linux__
 #include <unistd.h>
 #include <sys/inotify.h>
@@ -225,12 +226,10 @@ namespace Nickvision::Filesystem
         watches.push_back(inotify_add_watch(m_notify, m_path.c_str(), mask));
         if (m_includeSubdirectories)
         {
-            for (const std::filesystem::directory_entry& e : std::filesystem::recursive_directory_iterator(m_path))
+            //Symbolic links to directories are watched (inotify follows them), but not descended into
+            for (const std::filesystem::path& directory : DirectoryScanner::scan(m_path, ScanFlags::Directories | ScanFlags::Recursive | ScanFlags::FollowSymlinks))
             {
-                if (e.is_directory())
-                {
-                    watches.push_back(inotify_add_watch(m_notify, e.path().string().c_str(), mask));
-                }
+                watches.push_back(inotify_add_watch(m_notify, directory.c_str(), mask));
             }
         }
         while (m_watching)
@@ -0,0 +1,138 @@
+#include "filesystem/mappedfile.h"
+#include <stdexcept>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Nickvision::Filesystem
+{
+    MappedFile::MappedFile(const std::filesystem::path& path)
+        : m_path{ path },
+        m_data{ nullptr },
+        m_size{ 0 }
+    {
+#ifdef _WIN32
+        HANDLE file{ CreateFileW(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Unable to open file.");
+        }
+        LARGE_INTEGER size;
+        if(!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            throw std::runtime_error("Unable to get file size.");
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+        //Empty files cannot be mapped
+        if(m_size == 0)
+        {
+            CloseHandle(file);
+            return;
+        }
+        HANDLE mapping{ CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+        CloseHandle(file);
+        if(!mapping)
+        {
+            throw std::runtime_error("Unable to create file mapping.");
+        }
+        //The view keeps the mapping alive, so its handle is not needed after this
+        m_data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+        if(!m_data)
+        {
+            throw std::runtime_error("Unable to map file.");
+        }
+#else
+        int fd{ open(m_path.c_str(), O_RDONLY | O_CLOEXEC) };
+        if(fd == -1)
+        {
+            throw std::runtime_error("Unable to open file.");
+        }
+        struct stat st;
+        if(fstat(fd, &st) == -1 || !S_ISREG(st.st_mode))
+        {
+            close(fd);
+            throw std::runtime_error("Unable to get file size.");
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        //Empty files cannot be mapped
+        if(m_size == 0)
+        {
+            close(fd);
+            return;
+        }
+        //The mapping stays valid after the descriptor is closed
+        void* data{ mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0) };
+        close(fd);
+        if(data == MAP_FAILED)
+        {
+            throw std::runtime_error("Unable to map file.");
+        }
+        madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const std::byte*>(data);
+#endif
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_path{ std::move(other.m_path) },
+        m_data{ other.m_data },
+        m_size{ other.m_size }
+    {
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    MappedFile::~MappedFile() noexcept
+    {
+        unmap();
+    }
+
+    const std::filesystem::path& MappedFile::getPath() const noexcept
+    {
+        return m_path;
+    }
+
+    size_t MappedFile::size() const noexcept
+    {
+        return m_size;
+    }
+
+    std::span<const std::byte> MappedFile::getBytes() const noexcept
+    {
+        return { m_data, m_data ? m_size : 0 };
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if(this != &other)
+        {
+            unmap();
+            m_path = std::move(other.m_path);
+            m_data = other.m_data;
+            m_size = other.m_size;
+            other.m_data = nullptr;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    void MappedFile::unmap() noexcept
+    {
+        if(!m_data)
+        {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+    }
+}
@@ -50,14 +50,16 @@ namespace Nickvision::Filesystem
             {
                 continue;
             }
-            std::vector<std::string> pair{ StringHelpers::split(line, "=") };
-            if (pair[0] == key)
+            StringHelpers::SplitView pair{ line, '=' };
+            StringHelpers::SplitView::Iterator it{ pair.begin() };
+            if (*it == key && ++it != pair.end())
             {
-                if (pair[1].find("$HOME") != std::string::npos)
+                std::string value{ *it };
+                if (value.find("$HOME") != std::string::npos)
                 {
-                    pair[1].replace(pair[1].find("$HOME"), 5, UserDirectories::get(UserDirectory::Home).string());
+                    value.replace(value.find("$HOME"), 5, UserDirectories::get(UserDirectory::Home).string());
                 }
-                return StringHelpers::trim(pair[1], '"');
+                return StringHelpers::trim(value, '"');
             }
         }
         return { };
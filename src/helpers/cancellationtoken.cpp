@@ -35,10 +35,12 @@ namespace Nickvision::Helpers
             return;
         }
         m_cancelled = true;
-        if(m_cancelFunction)
+        //Copied, so the function can be replaced by another thread while it runs outside the lock
+        std::function<void()> cancelFunction{ m_cancelFunction };
+        lock.unlock();
+        if(cancelFunction)
         {
-            lock.unlock();
-            m_cancelFunction();
+            cancelFunction();
         }
     }
 
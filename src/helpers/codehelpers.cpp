@@ -1,5 +1,7 @@
 #include "helpers/codehelpers.h"
-#include <fstream>
+#include "filesystem/atomicfilewriter.h"
+#include "filesystem/chunkedfilereader.h"
+#include "filesystem/mappedfile.h"
 #ifdef _WIN32
 #include <windows.h>
 #else
@@ -7,6 +9,8 @@
 #include <string.h>
 #endif
 
+using namespace Nickvision::Filesystem;
+
 namespace Nickvision::Helpers
 {
     size_t CodeHelpers::combineHash(size_t a, size_t b) noexcept
@@ -52,32 +56,52 @@ namespace Nickvision::Helpers
 
     std::vector<std::byte> CodeHelpers::readFileBytes(const std::filesystem::path& path) noexcept
     {
-        if(!std::filesystem::exists(path))
+        //Copy straight out of a mapping of the file, so the vector is never zero-filled first
+        try
         {
-            return {};
+            MappedFile file{ path };
+            if(file.size() > 0)
+            {
+                std::span<const std::byte> bytes{ file.getBytes() };
+                return { bytes.begin(), bytes.end() };
+            }
+        }
+        catch(...)
+        {
+
         }
-        std::ifstream file{ path, std::ios::binary };
-        if(file.good())
+        //Files that cannot be mapped or report no size (such as pipes and special files) are read in chunks instead
+        try
         {
-            std::vector<std::byte> bytes(std::filesystem::file_size(path));
-            file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            std::vector<std::byte> bytes;
+            ChunkedFileReader reader{ path };
+            while(!reader.isEndOfFile())
+            {
+                std::span<const std::byte> chunk{ reader.read() };
+                bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+            }
             return bytes;
         }
-        return {};
+        catch(...)
+        {
+            return {};
+        }
     }
 
-    bool CodeHelpers::writeFileBytes(const std::filesystem::path& path, const std::vector<std::byte>& bytes, bool overwrite) noexcept
+    bool CodeHelpers::writeFileBytes(const std::filesystem::path& path, const std::vector<std::byte>& bytes, bool overwrite, bool durable) noexcept
     {
         if(std::filesystem::exists(path) && !overwrite)
         {
             return false;
         }
-        std::ofstream file{ path, std::ios::binary | std::ios::trunc };
-        if(file.good())
+        try
         {
-            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
-            return true;
+            AtomicFileWriter writer{ path, durable };
+            return writer.write(bytes) && writer.commit();
+        }
+        catch(...)
+        {
+            return false;
         }
-        return false;
     }
 }
@@ -0,0 +1,46 @@
+#include "helpers/hashedstring.h"
+#include "helpers/hashhelpers.h"
+
+namespace Nickvision::Helpers
+{
+    HashedString::HashedString(std::string s) noexcept
+        : m_string{ std::move(s) },
+        m_hash{ HashHelpers::hash64(m_string) }
+    {
+
+    }
+
+    HashedString::HashedString(std::string_view s) noexcept
+        : m_string{ s },
+        m_hash{ HashHelpers::hash64(m_string) }
+    {
+
+    }
+
+    HashedString::HashedString(const char* s) noexcept
+        : m_string{ s },
+        m_hash{ HashHelpers::hash64(m_string) }
+    {
+
+    }
+
+    const std::string& HashedString::str() const noexcept
+    {
+        return m_string;
+    }
+
+    std::uint64_t HashedString::getHash() const noexcept
+    {
+        return m_hash;
+    }
+
+    bool HashedString::operator==(const HashedString& other) const noexcept
+    {
+        return m_hash == other.m_hash && m_string == other.m_string;
+    }
+
+    HashedString::operator std::string_view() const noexcept
+    {
+        return m_string;
+    }
+}
@@ -0,0 +1,300 @@
+#include "helpers/hashhelpers.h"
+#include <bit>
+#include <cstring>
+#include "filesystem/chunkedfilereader.h"
+#include "filesystem/mappedfile.h"
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+using namespace Nickvision::Filesystem;
+
+namespace Nickvision::Helpers
+{
+    /**
+     * @brief The secret constants of wyhash.
+     */
+    static constexpr std::uint64_t secret[4]{ 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+    /**
+     * @brief Multiplies two values into a 128-bit product, storing the low half in a and the high half in b.
+     * @param a The first value
+     * @param b The second value
+     */
+    static inline void multiply(std::uint64_t& a, std::uint64_t& b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ using uint128 = unsigned __int128;
+        uint128 product{ static_cast<uint128>(a) * b };
+        a = static_cast<std::uint64_t>(product);
+        b = static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+#else
+        std::uint64_t ha{ a >> 32 };
+        std::uint64_t hb{ b >> 32 };
+        std::uint64_t la{ static_cast<std::uint32_t>(a) };
+        std::uint64_t lb{ static_cast<std::uint32_t>(b) };
+        std::uint64_t rh{ ha * hb };
+        std::uint64_t rm0{ ha * lb };
+        std::uint64_t rm1{ hb * la };
+        std::uint64_t rl{ la * lb };
+        std::uint64_t t{ rl + (rm0 << 32) };
+        std::uint64_t c{ t < rl };
+        std::uint64_t lo{ t + (rm1 << 32) };
+        c += lo < t;
+        std::uint64_t hi{ rh + (rm0 >> 32) + (rm1 >> 32) + c };
+        a = lo;
+        b = hi;
+#endif
+    }
+
+    /**
+     * @brief Reads a little-endian 64-bit value.
+     * @param p The bytes to read
+     * @return The value
+     */
+    static inline std::uint64_t read64(const std::byte* p) noexcept
+    {
+        std::uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        if constexpr(std::endian::native == std::endian::big)
+        {
+            value = ((value & 0x00000000000000ffull) << 56) | ((value & 0x000000000000ff00ull) << 40) | ((value & 0x0000000000ff0000ull) << 24) | ((value & 0x00000000ff000000ull) << 8) | ((value & 0x000000ff00000000ull) >> 8) | ((value & 0x0000ff0000000000ull) >> 24) | ((value & 0x00ff000000000000ull) >> 40) | ((value & 0xff00000000000000ull) >> 56);
+        }
+        return value;
+    }
+
+    /**
+     * @brief Reads a little-endian 32-bit value.
+     * @param p The bytes to read
+     * @return The value
+     */
+    static inline std::uint64_t read32(const std::byte* p) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        if constexpr(std::endian::native == std::endian::big)
+        {
+            value = ((value & 0x000000ffu) << 24) | ((value & 0x0000ff00u) << 8) | ((value & 0x00ff0000u) >> 8) | ((value & 0xff000000u) >> 24);
+        }
+        return value;
+    }
+
+    /**
+     * @brief Reads 1 to 3 bytes into a value.
+     * @param p The bytes to read
+     * @param size The number of bytes
+     * @return The value
+     */
+    static inline std::uint64_t read3(const std::byte* p, size_t size) noexcept
+    {
+        return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[size >> 1]) << 8) | static_cast<std::uint64_t>(p[size - 1]);
+    }
+
+    std::uint64_t HashHelpers::mix(std::uint64_t a, std::uint64_t b) noexcept
+    {
+        multiply(a, b);
+        return a ^ b;
+    }
+
+    /**
+     * @brief Mixes a 48 byte stripe into three lanes.
+     * @brief The lanes are independent, allowing their multiplications to execute in parallel.
+     * @param stripe The stripe to mix
+     * @param lane0 The first lane
+     * @param lane1 The second lane
+     * @param lane2 The third lane
+     */
+    static inline void mixStripe(const std::byte* stripe, std::uint64_t& lane0, std::uint64_t& lane1, std::uint64_t& lane2) noexcept
+    {
+        std::uint64_t a0{ read64(stripe) ^ secret[1] };
+        std::uint64_t b0{ read64(stripe + 8) ^ lane0 };
+        std::uint64_t a1{ read64(stripe + 16) ^ secret[2] };
+        std::uint64_t b1{ read64(stripe + 24) ^ lane1 };
+        std::uint64_t a2{ read64(stripe + 32) ^ secret[3] };
+        std::uint64_t b2{ read64(stripe + 40) ^ lane2 };
+        multiply(a0, b0);
+        multiply(a1, b1);
+        multiply(a2, b2);
+        lane0 = a0 ^ b0;
+        lane1 = a1 ^ b1;
+        lane2 = a2 ^ b2;
+    }
+
+    HashHelpers::Hasher::Hasher(std::uint64_t seed) noexcept
+    {
+        reset(seed);
+    }
+
+    void HashHelpers::Hasher::reset(std::uint64_t seed) noexcept
+    {
+        seed ^= mix(seed ^ secret[0], secret[1]);
+        m_lanes = { seed, seed, seed };
+        m_bufferSize = 0;
+        m_length = 0;
+    }
+
+    HashHelpers::Hasher& HashHelpers::Hasher::update(std::span<const std::byte> bytes) noexcept
+    {
+        const std::byte* data{ bytes.data() };
+        size_t size{ bytes.size() };
+        m_length += size;
+        if(m_bufferSize + size < m_buffer.size())
+        {
+            if(size > 0)
+            {
+                std::memcpy(m_buffer.data() + m_bufferSize, data, size);
+                m_bufferSize += size;
+            }
+            return *this;
+        }
+        //Complete the buffered stripe
+        if(m_bufferSize > 0)
+        {
+            size_t fill{ m_buffer.size() - m_bufferSize };
+            std::memcpy(m_buffer.data() + m_bufferSize, data, fill);
+            consume(m_buffer.data());
+            data += fill;
+            size -= fill;
+            m_bufferSize = 0;
+        }
+        //Mix full stripes directly from the input, keeping the lanes in registers
+        std::uint64_t lane0{ m_lanes[0] };
+        std::uint64_t lane1{ m_lanes[1] };
+        std::uint64_t lane2{ m_lanes[2] };
+        while(size >= m_buffer.size())
+        {
+            mixStripe(data, lane0, lane1, lane2);
+            data += m_buffer.size();
+            size -= m_buffer.size();
+        }
+        m_lanes = { lane0, lane1, lane2 };
+        if(size > 0)
+        {
+            std::memcpy(m_buffer.data(), data, size);
+            m_bufferSize = size;
+        }
+        return *this;
+    }
+
+    HashHelpers::Hasher& HashHelpers::Hasher::update(std::string_view s) noexcept
+    {
+        return update(std::span<const std::byte>{ reinterpret_cast<const std::byte*>(s.data()), s.size() });
+    }
+
+    std::uint64_t HashHelpers::Hasher::digest64() const noexcept
+    {
+        std::uint64_t a;
+        std::uint64_t b;
+        finalize(m_lanes[0] ^ m_lanes[1] ^ m_lanes[2], a, b);
+        return mix(a ^ secret[0] ^ m_length, b ^ secret[1]);
+    }
+
+    HashHelpers::Hash128 HashHelpers::Hasher::digest128() const noexcept
+    {
+        std::uint64_t a;
+        std::uint64_t b;
+        finalize(m_lanes[0] ^ m_lanes[1] ^ m_lanes[2], a, b);
+        Hash128 hash;
+        hash.low = mix(a ^ secret[0] ^ m_length, b ^ secret[1]);
+        //The high half is derived from a different combination of the lanes, so it is independent of the low half
+        finalize(mix(m_lanes[0] ^ secret[2], m_lanes[1] ^ secret[3]) ^ m_lanes[2], a, b);
+        hash.high = mix(a ^ secret[2] ^ m_length, b ^ secret[3]);
+        return hash;
+    }
+
+    void HashHelpers::Hasher::consume(const std::byte* stripe) noexcept
+    {
+        mixStripe(stripe, m_lanes[0], m_lanes[1], m_lanes[2]);
+    }
+
+    void HashHelpers::Hasher::finalize(std::uint64_t seed, std::uint64_t& a, std::uint64_t& b) const noexcept
+    {
+        const std::byte* p{ m_buffer.data() };
+        size_t size{ m_bufferSize };
+        if(size <= 16)
+        {
+            if(size >= 4)
+            {
+                a = (read32(p) << 32) | read32(p + ((size >> 3) << 2));
+                b = (read32(p + size - 4) << 32) | read32(p + size - 4 - ((size >> 3) << 2));
+            }
+            else if(size > 0)
+            {
+                a = read3(p, size);
+                b = 0;
+            }
+            else
+            {
+                a = 0;
+                b = 0;
+            }
+        }
+        else
+        {
+            while(size > 16)
+            {
+                seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+                p += 16;
+                size -= 16;
+            }
+            a = read64(p + size - 16);
+            b = read64(p + size - 8);
+        }
+        a ^= secret[1];
+        b ^= seed;
+        multiply(a, b);
+    }
+
+    std::uint64_t HashHelpers::hash64(std::span<const std::byte> bytes, std::uint64_t seed) noexcept
+    {
+        return Hasher{ seed }.update(bytes).digest64();
+    }
+
+    std::uint64_t HashHelpers::hash64(std::string_view s, std::uint64_t seed) noexcept
+    {
+        return Hasher{ seed }.update(s).digest64();
+    }
+
+    HashHelpers::Hash128 HashHelpers::hash128(std::span<const std::byte> bytes, std::uint64_t seed) noexcept
+    {
+        return Hasher{ seed }.update(bytes).digest128();
+    }
+
+    HashHelpers::Hash128 HashHelpers::hash128(std::string_view s, std::uint64_t seed) noexcept
+    {
+        return Hasher{ seed }.update(s).digest128();
+    }
+
+    HashHelpers::Hash128 HashHelpers::hashFile(const std::filesystem::path& path, std::uint64_t seed) noexcept
+    {
+        try
+        {
+            MappedFile file{ path };
+            if(file.size() > 0)
+            {
+                return hash128(file.getBytes(), seed);
+            }
+        }
+        catch(...)
+        {
+
+        }
+        //Files that cannot be mapped or report no size (such as pipes and special files) are read in chunks instead
+        try
+        {
+            Hasher hasher{ seed };
+            ChunkedFileReader reader{ path };
+            while(!reader.isEndOfFile())
+            {
+                hasher.update(reader.read());
+            }
+            return hasher.digest128();
+        }
+        catch(...)
+        {
+            return { 0, 0 };
+        }
+    }
+}
@@ -0,0 +1,164 @@
+#include "helpers/jsonarrayreader.h"
+
+using namespace Nickvision::Filesystem;
+
+namespace Nickvision::Helpers
+{
+    static bool isJsonWhitespace(char ch) noexcept
+    {
+        return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+    }
+
+    JsonArrayReader::JsonArrayReader(const std::filesystem::path& path)
+        : m_file{ std::make_unique<ChunkedFileReader>(path) },
+        m_position{ 0 },
+        m_state{ State::Start },
+        m_count{ 0 }
+    {
+
+    }
+
+    JsonArrayReader::JsonArrayReader(std::span<const std::byte> json) noexcept
+        : m_chunk{ reinterpret_cast<const char*>(json.data()), json.size() },
+        m_position{ 0 },
+        m_state{ State::Start },
+        m_count{ 0 }
+    {
+
+    }
+
+    size_t JsonArrayReader::getCount() const noexcept
+    {
+        return m_count;
+    }
+
+    bool JsonArrayReader::hasError() const noexcept
+    {
+        return m_state == State::Error;
+    }
+
+    std::optional<boost::json::value> JsonArrayReader::next() noexcept
+    {
+        if(m_state == State::Start)
+        {
+            while(fill() && isJsonWhitespace(m_chunk[m_position]))
+            {
+                m_position++;
+            }
+            if(!fill() || m_chunk[m_position] != '[')
+            {
+                return fail();
+            }
+            m_position++;
+            m_state = State::FirstElement;
+        }
+        if(m_state == State::End || m_state == State::Error)
+        {
+            return std::nullopt;
+        }
+        try
+        {
+            //Find the comma or bracket that ends the element, copying the element's text in runs
+            m_element.clear();
+            size_t depth{ 0 };
+            bool inString{ false };
+            bool escaped{ false };
+            while(true)
+            {
+                if(!fill())
+                {
+                    return fail();
+                }
+                size_t start{ m_position };
+                char end{ '\0' };
+                for(; m_position < m_chunk.size(); m_position++)
+                {
+                    char ch{ m_chunk[m_position] };
+                    if(inString)
+                    {
+                        if(escaped)
+                        {
+                            escaped = false;
+                        }
+                        else if(ch == '\\')
+                        {
+                            escaped = true;
+                        }
+                        else if(ch == '"')
+                        {
+                            inString = false;
+                        }
+                    }
+                    else if(ch == '"')
+                    {
+                        inString = true;
+                    }
+                    else if(ch == '[' || ch == '{')
+                    {
+                        depth++;
+                    }
+                    else if(depth > 0 && (ch == ']' || ch == '}'))
+                    {
+                        depth--;
+                    }
+                    else if(depth == 0 && (ch == ',' || ch == ']' || ch == '}'))
+                    {
+                        end = ch;
+                        break;
+                    }
+                }
+                m_element.append(m_chunk.substr(start, m_position - start));
+                if(end == '\0')
+                {
+                    continue;
+                }
+                m_position++;
+                bool empty{ m_element.find_first_not_of(" \t\n\r") == std::string::npos };
+                if(end == ']' && empty && m_state == State::FirstElement)
+                {
+                    m_state = State::End;
+                    return std::nullopt;
+                }
+                if(end == '}' || empty)
+                {
+                    return fail();
+                }
+                m_state = end == ']' ? State::End : State::Element;
+                boost::system::error_code ec;
+                m_parser.reset();
+                m_parser.write(m_element, ec);
+                if(ec)
+                {
+                    return fail();
+                }
+                m_count++;
+                return m_parser.release();
+            }
+        }
+        catch(...)
+        {
+            return fail();
+        }
+    }
+
+    bool JsonArrayReader::fill() noexcept
+    {
+        while(m_position == m_chunk.size())
+        {
+            if(!m_file || m_file->isEndOfFile())
+            {
+                return false;
+            }
+            std::span<const std::byte> bytes{ m_file->read() };
+            m_chunk = { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+            m_position = 0;
+        }
+        return true;
+    }
+
+    std::nullopt_t JsonArrayReader::fail() noexcept
+    {
+        m_state = State::Error;
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,103 @@
+#include "helpers/jsonarraywriter.h"
+
+#define SERIALIZE_BUFFER_SIZE 4096
+
+using namespace Nickvision::Filesystem;
+
+namespace Nickvision::Helpers
+{
+    JsonArrayWriter::JsonArrayWriter(const std::filesystem::path& path)
+        : m_file{ std::make_unique<AtomicFileWriter>(path) },
+        m_buffer{ nullptr },
+        m_count{ 0 },
+        m_finished{ false }
+    {
+
+    }
+
+    JsonArrayWriter::JsonArrayWriter(std::string& buffer) noexcept
+        : m_buffer{ &buffer },
+        m_count{ 0 },
+        m_finished{ false }
+    {
+
+    }
+
+    size_t JsonArrayWriter::getCount() const noexcept
+    {
+        return m_count;
+    }
+
+    bool JsonArrayWriter::isFinished() const noexcept
+    {
+        return m_finished;
+    }
+
+    bool JsonArrayWriter::write(const IJsonSerializable& element) noexcept
+    {
+        if(!beginElement())
+        {
+            return false;
+        }
+        return append(element.toJsonString());
+    }
+
+    bool JsonArrayWriter::write(const boost::json::value& element) noexcept
+    {
+        if(!beginElement())
+        {
+            return false;
+        }
+        boost::json::serializer serializer;
+        serializer.reset(&element);
+        char buffer[SERIALIZE_BUFFER_SIZE];
+        while(!serializer.done())
+        {
+            if(!append(serializer.read(buffer, sizeof(buffer))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool JsonArrayWriter::finish() noexcept
+    {
+        if(m_finished)
+        {
+            return false;
+        }
+        m_finished = true;
+        if(!append(m_count == 0 ? "[]\n" : "]\n"))
+        {
+            return false;
+        }
+        return !m_file || m_file->commit();
+    }
+
+    bool JsonArrayWriter::beginElement() noexcept
+    {
+        if(m_finished)
+        {
+            return false;
+        }
+        return append(m_count++ == 0 ? "[" : ",");
+    }
+
+    bool JsonArrayWriter::append(std::string_view s) noexcept
+    {
+        if(m_file)
+        {
+            return m_file->write(s);
+        }
+        try
+        {
+            m_buffer->append(s);
+            return true;
+        }
+        catch(...)
+        {
+            return false;
+        }
+    }
+}
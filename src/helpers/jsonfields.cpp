@@ -0,0 +1,54 @@
+#include "helpers/jsonfields.h"
+
+namespace Nickvision::Helpers
+{
+    void JsonFields::appendString(std::string& json, std::string_view s) noexcept
+    {
+        static constexpr char hex[]{ "0123456789abcdef" };
+        json.reserve(json.size() + s.size() + 2);
+        json += '"';
+        size_t start{ 0 };
+        for(size_t i = 0; i < s.size(); i++)
+        {
+            unsigned char ch{ static_cast<unsigned char>(s[i]) };
+            if(ch >= 0x20 && ch != '"' && ch != '\\')
+            {
+                continue;
+            }
+            //Unescaped runs are appended all at once
+            json.append(s, start, i - start);
+            start = i + 1;
+            switch(ch)
+            {
+            case '"':
+                json += "\\\"";
+                break;
+            case '\\':
+                json += "\\\\";
+                break;
+            case '\b':
+                json += "\\b";
+                break;
+            case '\f':
+                json += "\\f";
+                break;
+            case '\n':
+                json += "\\n";
+                break;
+            case '\r':
+                json += "\\r";
+                break;
+            case '\t':
+                json += "\\t";
+                break;
+            default:
+                json += "\\u00";
+                json += hex[ch >> 4];
+                json += hex[ch & 0xF];
+                break;
+            }
+        }
+        json.append(s, start, s.size() - start);
+        json += '"';
+    }
+}
@@ -1,36 +1,377 @@
 #include "helpers/jsonfilebase.h"
-#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
+#include "filesystem/atomicfilewriter.h"
+#include "filesystem/mappedfile.h"
+#include "helpers/hashhelpers.h"
+#include "helpers/jsonpatch.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define SNAPSHOT_MAGIC 0x534A564E
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_MAX_DEPTH 64
+
+using namespace Nickvision::Filesystem;
 
 namespace Nickvision::Helpers
 {
-    JsonFileBase::JsonFileBase(const std::filesystem::path& path)
-        : m_path{ path }
+    /**
+     * @brief The tag preceding each value in a snapshot.
+     */
+    enum class SnapshotTag : unsigned char
     {
-        if (m_path.empty())
+        Null = 0,
+        False,
+        True,
+        Int64,
+        Uint64,
+        Double,
+        String,
+        Array,
+        Object
+    };
+
+    /**
+     * @brief The header of a snapshot file.
+     * @brief Values are stored in the native byte order, a snapshot written on a machine with a different byte order fails the magic check.
+     */
+    struct SnapshotHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t sourceSize;
+        std::int64_t sourceTime;
+        std::uint64_t sourceHashLow;
+        std::uint64_t sourceHashHigh;
+    };
+
+    /**
+     * @brief Writes data to a file at an offset.
+     * @brief Anything in the file past the offset is removed first.
+     * @param path The path of the file, which is created if it does not exist
+     * @param offset The offset to write the data at
+     * @param data The data to write
+     * @param durable Whether or not to flush the file to the storage device
+     * @return True if successful, else false
+     */
+    static bool writeFileAt(const std::filesystem::path& path, std::uint64_t offset, std::string_view data, bool durable) noexcept
+    {
+#ifdef _WIN32
+        HANDLE file{ CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        if(file == INVALID_HANDLE_VALUE)
         {
-            throw std::invalid_argument("Path must not be empty.");
+            return false;
+        }
+        LARGE_INTEGER position;
+        position.QuadPart = static_cast<LONGLONG>(offset);
+        DWORD written{ 0 };
+        bool success{ SetFilePointerEx(file, position, nullptr, FILE_BEGIN) && SetEndOfFile(file) && WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &written, nullptr) && written == data.size() && (!durable || FlushFileBuffers(file)) };
+        CloseHandle(file);
+        return success;
+#else
+        int file{ open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644) };
+        if(file == -1)
+        {
+            return false;
+        }
+        bool success{ ftruncate(file, static_cast<off_t>(offset)) == 0 };
+        size_t written{ 0 };
+        while(success && written < data.size())
+        {
+            ssize_t result{ pwrite(file, data.data() + written, data.size() - written, static_cast<off_t>(offset + written)) };
+            if(result == -1 && errno == EINTR)
+            {
+                continue;
+            }
+            success = result > 0;
+            written += success ? static_cast<size_t>(result) : 0;
+        }
+        if(durable)
+        {
+#ifdef __APPLE__
+            success = success && (fcntl(file, F_FULLFSYNC) != -1 || fsync(file) != -1);
+#else
+            success = success && fdatasync(file) != -1;
+#endif
+        }
+        close(file);
+        return success;
+#endif
+    }
+
+    /**
+     * @brief Creates a journal entry for changed values.
+     * @brief Each changed top-level value is recorded whole, as a single add operation.
+     * @param changes The changed top-level values
+     * @return The JSON Patch of the changed values, followed by a new line
+     */
+    static std::string createJournalEntry(const boost::json::object& changes)
+    {
+        boost::json::array patch;
+        patch.reserve(changes.size());
+        for(const boost::json::key_value_pair& pair : changes)
+        {
+            patch.push_back(boost::json::object{ { "op", "add" }, { "path", "/" + JsonPatch::escape(pair.key()) }, { "value", pair.value() } });
+        }
+        std::string entry{ boost::json::serialize(patch) };
+        entry += '\n';
+        return entry;
+    }
+
+    static std::int64_t getLastWriteTime(const std::filesystem::path& path) noexcept
+    {
+        std::error_code ec;
+        std::filesystem::file_time_type time{ std::filesystem::last_write_time(path, ec) };
+        return ec ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
+    }
+
+    template<typename T>
+    static void appendSnapshotRaw(std::string& buffer, const T& value)
+    {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static bool appendSnapshotString(std::string& buffer, std::string_view s)
+    {
+        if(s.size() > std::numeric_limits<std::uint32_t>::max())
+        {
+            return false;
+        }
+        appendSnapshotRaw(buffer, static_cast<std::uint32_t>(s.size()));
+        buffer.append(s);
+        return true;
+    }
+
+    static bool encodeSnapshotValue(std::string& buffer, const boost::json::value& value, unsigned int depth);
+
+    static bool encodeSnapshotObject(std::string& buffer, const boost::json::object& object, unsigned int depth)
+    {
+        if(depth > SNAPSHOT_MAX_DEPTH || object.size() > std::numeric_limits<std::uint32_t>::max())
+        {
+            return false;
+        }
+        buffer += static_cast<char>(SnapshotTag::Object);
+        appendSnapshotRaw(buffer, static_cast<std::uint32_t>(object.size()));
+        for(const boost::json::key_value_pair& pair : object)
+        {
+            if(!appendSnapshotString(buffer, pair.key()) || !encodeSnapshotValue(buffer, pair.value(), depth + 1))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool encodeSnapshotValue(std::string& buffer, const boost::json::value& value, unsigned int depth)
+    {
+        switch(value.kind())
+        {
+        case boost::json::kind::null:
+            buffer += static_cast<char>(SnapshotTag::Null);
+            return true;
+        case boost::json::kind::bool_:
+            buffer += static_cast<char>(value.as_bool() ? SnapshotTag::True : SnapshotTag::False);
+            return true;
+        case boost::json::kind::int64:
+            buffer += static_cast<char>(SnapshotTag::Int64);
+            appendSnapshotRaw(buffer, value.as_int64());
+            return true;
+        case boost::json::kind::uint64:
+            buffer += static_cast<char>(SnapshotTag::Uint64);
+            appendSnapshotRaw(buffer, value.as_uint64());
+            return true;
+        case boost::json::kind::double_:
+            buffer += static_cast<char>(SnapshotTag::Double);
+            appendSnapshotRaw(buffer, value.as_double());
+            return true;
+        case boost::json::kind::string:
+            buffer += static_cast<char>(SnapshotTag::String);
+            return appendSnapshotString(buffer, value.as_string());
+        case boost::json::kind::array:
+        {
+            const boost::json::array& array{ value.as_array() };
+            if(depth > SNAPSHOT_MAX_DEPTH || array.size() > std::numeric_limits<std::uint32_t>::max())
+            {
+                return false;
+            }
+            buffer += static_cast<char>(SnapshotTag::Array);
+            appendSnapshotRaw(buffer, static_cast<std::uint32_t>(array.size()));
+            for(const boost::json::value& element : array)
+            {
+                if(!encodeSnapshotValue(buffer, element, depth + 1))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case boost::json::kind::object:
+            return encodeSnapshotObject(buffer, value.as_object(), depth);
+        }
+        return false;
+    }
+
+    template<typename T>
+    static bool readSnapshotRaw(std::span<const std::byte>& data, T& value) noexcept
+    {
+        if(data.size() < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, data.data(), sizeof(T));
+        data = data.subspan(sizeof(T));
+        return true;
+    }
+
+    static bool readSnapshotString(std::span<const std::byte>& data, std::string_view& s) noexcept
+    {
+        std::uint32_t size;
+        if(!readSnapshotRaw(data, size) || data.size() < size)
+        {
+            return false;
+        }
+        s = { reinterpret_cast<const char*>(data.data()), size };
+        data = data.subspan(size);
+        return true;
+    }
+
+    static bool decodeSnapshotValue(std::span<const std::byte>& data, boost::json::value& value, unsigned int depth)
+    {
+        SnapshotTag tag;
+        if(depth > SNAPSHOT_MAX_DEPTH || !readSnapshotRaw(data, tag))
+        {
+            return false;
+        }
+        switch(tag)
+        {
+        case SnapshotTag::Null:
+            value.emplace_null();
+            return true;
+        case SnapshotTag::False:
+            value = false;
+            return true;
+        case SnapshotTag::True:
+            value = true;
+            return true;
+        case SnapshotTag::Int64:
+        {
+            std::int64_t i;
+            if(!readSnapshotRaw(data, i))
+            {
+                return false;
+            }
+            value = i;
+            return true;
+        }
+        case SnapshotTag::Uint64:
+        {
+            std::uint64_t u;
+            if(!readSnapshotRaw(data, u))
+            {
+                return false;
+            }
+            value = u;
+            return true;
         }
-        if (std::filesystem::exists(m_path))
+        case SnapshotTag::Double:
         {
-            try
+            double d;
+            if(!readSnapshotRaw(data, d))
             {
-                std::ifstream in{ m_path };
-                boost::json::stream_parser parser;
-                std::string line;
-                while(std::getline(in, line))
+                return false;
+            }
+            value = d;
+            return true;
+        }
+        case SnapshotTag::String:
+        {
+            std::string_view s;
+            if(!readSnapshotString(data, s))
+            {
+                return false;
+            }
+            value.emplace_string() = s;
+            return true;
+        }
+        case SnapshotTag::Array:
+        {
+            std::uint32_t count;
+            //Every element takes at least one byte, so a larger count can only come from a corrupt file
+            if(!readSnapshotRaw(data, count) || count > data.size())
+            {
+                return false;
+            }
+            boost::json::array& array{ value.emplace_array() };
+            array.reserve(count);
+            for(std::uint32_t i = 0; i < count; i++)
+            {
+                if(!decodeSnapshotValue(data, array.emplace_back(nullptr), depth + 1))
                 {
-                    parser.write(line);
+                    return false;
                 }
-                parser.finish();
-                boost::json::value value = parser.release();
-                if(value.is_object())
+            }
+            return true;
+        }
+        case SnapshotTag::Object:
+        {
+            std::uint32_t count;
+            if(!readSnapshotRaw(data, count) || count > data.size())
+            {
+                return false;
+            }
+            boost::json::object& object{ value.emplace_object() };
+            object.reserve(count);
+            for(std::uint32_t i = 0; i < count; i++)
+            {
+                std::string_view key;
+                boost::json::value element;
+                if(!readSnapshotString(data, key) || !decodeSnapshotValue(data, element, depth + 1))
                 {
-                    m_json = value.as_object();
+                    return false;
                 }
+                object.emplace(key, std::move(element));
             }
-            catch(...) { }
+            return true;
+        }
         }
+        return false;
+    }
+
+    JsonFileBase::JsonFileBase(const std::filesystem::path& path, bool loadLazily, bool useSnapshot)
+        : m_path{ path },
+        m_snapshotPath{ useSnapshot ? std::filesystem::path{ path }.concat(".snapshot") : std::filesystem::path{} },
+        m_journalPath{ std::filesystem::path{ path }.concat(".journal") },
+        m_loaded{ false },
+        m_generation{ 0 },
+        m_durableSave{ false },
+        m_journalCompactSize{ 0 },
+        m_journalSize{ 0 },
+        m_autoSaveDelay{ 0 },
+        m_dirty{ false },
+        m_stopAutoSave{ false }
+    {
+        if (m_path.empty())
+        {
+            throw std::invalid_argument("Path must not be empty.");
+        }
+        if(!loadLazily)
+        {
+            load();
+        }
+    }
+
+    JsonFileBase::~JsonFileBase() noexcept
+    {
+        //Derived members are already destroyed here, so the saved event must not be invoked
+        stopAutoSave(false);
     }
 
     const std::filesystem::path& JsonFileBase::getPath() const noexcept
@@ -47,27 +388,365 @@ namespace Nickvision::Helpers
 
     bool JsonFileBase::save() noexcept
     {
+        return saveFile(true);
+    }
+
+    bool JsonFileBase::saveFile(bool notify) noexcept
+    {
+        //Serializes saves, so an older snapshot can never overwrite a newer one
+        std::lock_guard saveLock{ m_saveMutex };
+        {
+            std::lock_guard lock{ m_autoSaveMutex };
+            m_dirty = false;
+        }
         std::unique_lock lock{ m_mutex };
+        load();
+        std::unordered_set<std::string> changedKeys;
+        changedKeys.swap(m_changedKeys);
+        bool durable{ m_durableSave };
+        std::uint64_t journalCompactSize{ m_journalCompactSize };
+        std::uint64_t journalSize{ m_journalSize };
+        bool useJournal{ journalCompactSize > 0 || journalSize > 0 };
+        //A journal save only copies the changed values, the whole object is only copied when the file is rewritten
+        boost::json::object changes;
+        if(useJournal)
+        {
+            for(const std::string& key : changedKeys)
+            {
+                if(const boost::json::value* value{ m_json.if_contains(key) })
+                {
+                    changes.emplace(key, *value);
+                }
+            }
+        }
+        lock.unlock();
         if(m_path.has_parent_path())
         {
-            std::filesystem::create_directories(m_path.parent_path());
+            std::error_code ec;
+            std::filesystem::create_directories(m_path.parent_path(), ec);
+        }
+        bool journaled{ false };
+        if(useJournal)
+        {
+            //Changes are always recorded in the journal first, so the journal never ends in an older state than a compacted file
+            if(!changes.empty())
+            {
+                std::string entry{ createJournalEntry(changes) };
+                if(!writeFileAt(m_journalPath, journalSize, entry, durable))
+                {
+                    lock.lock();
+                    m_changedKeys.merge(changedKeys);
+                    return false;
+                }
+                journaled = true;
+                journalSize += entry.size();
+                lock.lock();
+                m_journalSize = journalSize;
+                lock.unlock();
+            }
+            if(journalSize > 0 && journalSize <= journalCompactSize)
+            {
+                if(notify)
+                {
+                    m_saved({});
+                }
+                return true;
+            }
         }
-        std::ofstream out{ m_path };
-        out << m_json << std::endl;
+        //Values changed since the changed keys were taken are included in the file and journaled again by the next save, which is harmless
+        lock.lock();
+        boost::json::object snapshot{ m_json };
         lock.unlock();
-        m_saved({});
+        std::string json{ boost::json::serialize(snapshot) };
+        json += '\n';
+        bool written{ false };
+        try
+        {
+            //Write to a temporary file and rename it over the old file, so a crash never leaves a partially written file
+            AtomicFileWriter writer{ m_path, durable };
+            written = writer.write(json) && writer.commit();
+        }
+        catch(...)
+        {
+
+        }
+        if(!written)
+        {
+            if(!journaled)
+            {
+                lock.lock();
+                m_changedKeys.merge(changedKeys);
+            }
+            return false;
+        }
+        if(journalSize > 0)
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_journalPath, ec);
+            lock.lock();
+            m_journalSize = 0;
+            lock.unlock();
+        }
+        if(!m_snapshotPath.empty())
+        {
+            saveSnapshot(json, snapshot);
+        }
+        if(notify)
+        {
+            m_saved({});
+        }
         return true;
     }
 
+    bool JsonFileBase::isDurableSaveEnabled() const noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        return m_durableSave;
+    }
+
+    void JsonFileBase::enableDurableSave() noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        m_durableSave = true;
+    }
+
+    void JsonFileBase::disableDurableSave() noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        m_durableSave = false;
+    }
+
+    bool JsonFileBase::isJournalEnabled() const noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        return m_journalCompactSize > 0;
+    }
+
+    void JsonFileBase::enableJournal(std::uint64_t compactSize) noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        m_journalCompactSize = std::max<std::uint64_t>(compactSize, 1);
+    }
+
+    void JsonFileBase::disableJournal() noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        m_journalCompactSize = 0;
+    }
+
+    bool JsonFileBase::isAutoSaveEnabled() const noexcept
+    {
+        std::lock_guard lock{ m_autoSaveMutex };
+        return m_autoSaveDelay.count() > 0;
+    }
+
+    void JsonFileBase::enableAutoSave(std::chrono::milliseconds delay) noexcept
+    {
+        std::lock_guard lock{ m_autoSaveMutex };
+        m_autoSaveDelay = std::max(delay, std::chrono::milliseconds{ 1 });
+        if(!m_autoSaveThread.joinable())
+        {
+            m_stopAutoSave = false;
+            m_autoSaveThread = std::thread{ &JsonFileBase::autoSave, this };
+        }
+        m_autoSaveCondition.notify_all();
+    }
+
+    void JsonFileBase::disableAutoSave() noexcept
+    {
+        stopAutoSave(true);
+    }
+
+    void JsonFileBase::stopAutoSave(bool notify) noexcept
+    {
+        std::unique_lock lock{ m_autoSaveMutex };
+        if(!m_autoSaveThread.joinable())
+        {
+            return;
+        }
+        m_stopAutoSave = true;
+        m_autoSaveDelay = std::chrono::milliseconds{ 0 };
+        lock.unlock();
+        m_autoSaveCondition.notify_all();
+        m_autoSaveThread.join();
+        lock.lock();
+        bool dirty{ m_dirty };
+        lock.unlock();
+        if(dirty)
+        {
+            saveFile(notify);
+        }
+    }
+
     boost::json::value JsonFileBase::toJson() const noexcept
     {
         std::lock_guard lock{ m_mutex };
+        load();
         return m_json;
     }
 
+    void JsonFileBase::load() const noexcept
+    {
+        if(m_loaded)
+        {
+            return;
+        }
+        m_loaded = true;
+        try
+        {
+            //Map the whole file and parse it in a single pass
+            MappedFile file{ m_path };
+            std::span<const std::byte> bytes{ file.getBytes() };
+            if(!bytes.empty() && (m_snapshotPath.empty() || !loadSnapshot(bytes)))
+            {
+                //The parsed tree is built in a single preallocated block and then copied into m_json, which outlives it
+                boost::json::monotonic_resource resource{ bytes.size() * 2 };
+                boost::system::error_code ec;
+                boost::json::value value{ boost::json::parse(std::string_view{ reinterpret_cast<const char*>(bytes.data()), bytes.size() }, ec, &resource) };
+                if(!ec && value.is_object())
+                {
+                    m_json = value.as_object();
+                }
+            }
+        }
+        catch(...)
+        {
+
+        }
+        loadJournal();
+    }
+
+    void JsonFileBase::loadJournal() const noexcept
+    {
+        m_journalSize = 0;
+        try
+        {
+            MappedFile file{ m_journalPath };
+            std::string_view journal{ reinterpret_cast<const char*>(file.getBytes().data()), file.size() };
+            boost::json::value document{ std::move(m_json) };
+            size_t start{ 0 };
+            size_t end;
+            //Each line is a patch. A line that cannot be applied, such as one left partially written by a crash, ends the journal and is overwritten by the next save.
+            while((end = journal.find('\n', start)) != std::string_view::npos)
+            {
+                boost::system::error_code ec;
+                boost::json::value patch{ boost::json::parse(journal.substr(start, end - start), ec) };
+                if(ec || !patch.is_array() || !JsonPatch::apply(document, patch.as_array()))
+                {
+                    break;
+                }
+                start = end + 1;
+            }
+            m_journalSize = start;
+            if(document.is_object())
+            {
+                m_json = std::move(document.as_object());
+            }
+        }
+        catch(...)
+        {
+
+        }
+    }
+
+    bool JsonFileBase::loadSnapshot(std::span<const std::byte> source) const noexcept
+    {
+        try
+        {
+            MappedFile file{ m_snapshotPath };
+            std::span<const std::byte> data{ file.getBytes() };
+            SnapshotHeader header;
+            if(!readSnapshotRaw(data, header) || header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION)
+            {
+                return false;
+            }
+            //The size and modification time are checked first, as they are much cheaper to compare than the hash
+            if(header.sourceSize != source.size() || header.sourceTime != getLastWriteTime(m_path))
+            {
+                return false;
+            }
+            HashHelpers::Hash128 hash{ HashHelpers::hash128(source) };
+            if(header.sourceHashLow != hash.low || header.sourceHashHigh != hash.high)
+            {
+                return false;
+            }
+            boost::json::value value;
+            if(!decodeSnapshotValue(data, value, 0) || !data.empty() || !value.is_object())
+            {
+                return false;
+            }
+            m_json = std::move(value.as_object());
+            return true;
+        }
+        catch(...)
+        {
+            return false;
+        }
+    }
+
+    void JsonFileBase::saveSnapshot(std::string_view source, const boost::json::object& json) const noexcept
+    {
+        try
+        {
+            HashHelpers::Hash128 hash{ HashHelpers::hash128(source) };
+            SnapshotHeader header{ SNAPSHOT_MAGIC, SNAPSHOT_VERSION, source.size(), getLastWriteTime(m_path), hash.low, hash.high };
+            std::string buffer;
+            buffer.reserve(sizeof(SnapshotHeader) + source.size());
+            appendSnapshotRaw(buffer, header);
+            if(encodeSnapshotObject(buffer, json, 0))
+            {
+                //The snapshot is only a cache of the json file, so it does not need to be flushed to the storage device
+                AtomicFileWriter writer{ m_snapshotPath, false };
+                if(writer.write(buffer) && writer.commit())
+                {
+                    return;
+                }
+            }
+        }
+        catch(...)
+        {
+
+        }
+        std::error_code ec;
+        std::filesystem::remove(m_snapshotPath, ec);
+    }
+
+    void JsonFileBase::markDirty() noexcept
+    {
+        std::lock_guard lock{ m_autoSaveMutex };
+        if(!m_dirty)
+        {
+            m_dirty = true;
+            m_autoSaveCondition.notify_all();
+        }
+    }
+
+    void JsonFileBase::autoSave() noexcept
+    {
+        std::unique_lock lock{ m_autoSaveMutex };
+        while(true)
+        {
+            m_autoSaveCondition.wait(lock, [this]() { return m_dirty || m_stopAutoSave; });
+            if(m_stopAutoSave)
+            {
+                return;
+            }
+            //Coalesce all changes made within the delay of the first one into a single write
+            m_autoSaveCondition.wait_for(lock, m_autoSaveDelay, [this]() { return m_stopAutoSave; });
+            if(m_stopAutoSave)
+            {
+                return;
+            }
+            lock.unlock();
+            save();
+            lock.lock();
+        }
+    }
+
     bool JsonFileBase::contains(const std::string& key) const noexcept
     {
         std::lock_guard lock{ m_mutex };
+        load();
         return m_json.contains(key);
     }
 }
@@ -0,0 +1,287 @@
+#include "helpers/jsonpatch.h"
+#include <charconv>
+#include <optional>
+#include <vector>
+
+namespace Nickvision::Helpers
+{
+    /**
+     * @brief Splits a JSON Pointer into its unescaped tokens.
+     * @param pointer The JSON Pointer
+     * @param tokens The vector to store the tokens in
+     * @return True if the pointer is valid, else false
+     */
+    static bool parsePointer(std::string_view pointer, std::vector<std::string>& tokens) noexcept
+    {
+        tokens.clear();
+        if(pointer.empty())
+        {
+            return true;
+        }
+        if(pointer[0] != '/')
+        {
+            return false;
+        }
+        std::string token;
+        for(size_t i = 1; i <= pointer.size(); i++)
+        {
+            if(i == pointer.size() || pointer[i] == '/')
+            {
+                tokens.push_back(std::move(token));
+                token.clear();
+            }
+            else if(pointer[i] == '~')
+            {
+                if(i + 1 == pointer.size() || (pointer[i + 1] != '0' && pointer[i + 1] != '1'))
+                {
+                    return false;
+                }
+                token += pointer[++i] == '0' ? '~' : '/';
+            }
+            else
+            {
+                token += pointer[i];
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parses an array index token.
+     * @param token The token
+     * @return The index if the token is a valid index, else std::nullopt
+     */
+    static std::optional<size_t> parseIndex(std::string_view token) noexcept
+    {
+        if(token.empty() || (token.size() > 1 && token[0] == '0'))
+        {
+            return std::nullopt;
+        }
+        size_t index;
+        std::from_chars_result result{ std::from_chars(token.data(), token.data() + token.size(), index) };
+        if(result.ec != std::errc{} || result.ptr != token.data() + token.size())
+        {
+            return std::nullopt;
+        }
+        return index;
+    }
+
+    /**
+     * @brief Finds the value referenced by the first count tokens of a pointer.
+     * @param document The document
+     * @param tokens The tokens of the pointer
+     * @param count The number of tokens to follow
+     * @return The value if found, else nullptr
+     */
+    static boost::json::value* resolve(boost::json::value& document, const std::vector<std::string>& tokens, size_t count) noexcept
+    {
+        boost::json::value* current{ &document };
+        for(size_t i = 0; i < count; i++)
+        {
+            if(boost::json::object* object{ current->if_object() })
+            {
+                current = object->if_contains(tokens[i]);
+            }
+            else if(boost::json::array* array{ current->if_array() })
+            {
+                std::optional<size_t> index{ parseIndex(tokens[i]) };
+                current = index && *index < array->size() ? &(*array)[*index] : nullptr;
+            }
+            else
+            {
+                current = nullptr;
+            }
+            if(!current)
+            {
+                return nullptr;
+            }
+        }
+        return current;
+    }
+
+    static bool addValue(boost::json::value& document, const std::vector<std::string>& tokens, boost::json::value value)
+    {
+        if(tokens.empty())
+        {
+            document = std::move(value);
+            return true;
+        }
+        boost::json::value* parent{ resolve(document, tokens, tokens.size() - 1) };
+        if(!parent)
+        {
+            return false;
+        }
+        if(boost::json::object* object{ parent->if_object() })
+        {
+            object->insert_or_assign(tokens.back(), std::move(value));
+            return true;
+        }
+        if(boost::json::array* array{ parent->if_array() })
+        {
+            if(tokens.back() == "-")
+            {
+                array->push_back(std::move(value));
+                return true;
+            }
+            std::optional<size_t> index{ parseIndex(tokens.back()) };
+            if(!index || *index > array->size())
+            {
+                return false;
+            }
+            array->insert(array->begin() + *index, std::move(value));
+            return true;
+        }
+        return false;
+    }
+
+    static bool removeValue(boost::json::value& document, const std::vector<std::string>& tokens, boost::json::value* removed)
+    {
+        if(tokens.empty())
+        {
+            return false;
+        }
+        boost::json::value* parent{ resolve(document, tokens, tokens.size() - 1) };
+        if(!parent)
+        {
+            return false;
+        }
+        if(boost::json::object* object{ parent->if_object() })
+        {
+            boost::json::value* value{ object->if_contains(tokens.back()) };
+            if(!value)
+            {
+                return false;
+            }
+            if(removed)
+            {
+                *removed = std::move(*value);
+            }
+            object->erase(tokens.back());
+            return true;
+        }
+        if(boost::json::array* array{ parent->if_array() })
+        {
+            std::optional<size_t> index{ parseIndex(tokens.back()) };
+            if(!index || *index >= array->size())
+            {
+                return false;
+            }
+            if(removed)
+            {
+                *removed = std::move((*array)[*index]);
+            }
+            array->erase(array->begin() + *index);
+            return true;
+        }
+        return false;
+    }
+
+    static bool applyOperation(boost::json::value& document, const boost::json::object& operation)
+    {
+        const boost::json::value* op{ operation.if_contains("op") };
+        const boost::json::value* path{ operation.if_contains("path") };
+        if(!op || !op->is_string() || !path || !path->is_string())
+        {
+            return false;
+        }
+        std::vector<std::string> tokens;
+        if(!parsePointer(path->as_string(), tokens))
+        {
+            return false;
+        }
+        std::string_view name{ op->as_string() };
+        const boost::json::value* value{ operation.if_contains("value") };
+        if(name == "add")
+        {
+            return value && addValue(document, tokens, *value);
+        }
+        else if(name == "remove")
+        {
+            return removeValue(document, tokens, nullptr);
+        }
+        else if(name == "replace")
+        {
+            boost::json::value* target{ resolve(document, tokens, tokens.size()) };
+            if(!value || !target)
+            {
+                return false;
+            }
+            *target = *value;
+            return true;
+        }
+        else if(name == "test")
+        {
+            const boost::json::value* target{ resolve(document, tokens, tokens.size()) };
+            return value && target && *target == *value;
+        }
+        else if(name == "move" || name == "copy")
+        {
+            const boost::json::value* from{ operation.if_contains("from") };
+            std::vector<std::string> fromTokens;
+            if(!from || !from->is_string() || !parsePointer(from->as_string(), fromTokens))
+            {
+                return false;
+            }
+            if(name == "copy")
+            {
+                boost::json::value* source{ resolve(document, fromTokens, fromTokens.size()) };
+                return source && addValue(document, tokens, *source);
+            }
+            //A value cannot be moved into one of its own children
+            std::string_view fromPointer{ from->as_string() };
+            std::string_view toPointer{ path->as_string() };
+            if(toPointer.size() > fromPointer.size() && toPointer.starts_with(fromPointer) && toPointer[fromPointer.size()] == '/')
+            {
+                return false;
+            }
+            if(fromTokens == tokens)
+            {
+                return resolve(document, tokens, tokens.size()) != nullptr;
+            }
+            boost::json::value moved;
+            return removeValue(document, fromTokens, &moved) && addValue(document, tokens, std::move(moved));
+        }
+        return false;
+    }
+
+    bool JsonPatch::apply(boost::json::value& document, const boost::json::array& patch) noexcept
+    {
+        try
+        {
+            for(const boost::json::value& operation : patch)
+            {
+                if(!operation.is_object() || !applyOperation(document, operation.as_object()))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        catch(...)
+        {
+            return false;
+        }
+    }
+
+    std::string JsonPatch::escape(std::string_view key) noexcept
+    {
+        std::string escaped;
+        escaped.reserve(key.size());
+        for(char ch : key)
+        {
+            if(ch == '~')
+            {
+                escaped += "~0";
+            }
+            else if(ch == '/')
+            {
+                escaped += "~1";
+            }
+            else
+            {
+                escaped += ch;
+            }
+        }
+        return escaped;
+    }
+}
@@ -0,0 +1,70 @@
+#include "helpers/stringbuilder.h"
+
+namespace Nickvision::Helpers
+{
+    StringBuilder::StringBuilder(size_t capacity) noexcept
+    {
+        m_buffer.reserve(capacity);
+    }
+
+    StringBuilder& StringBuilder::append(std::string_view s) noexcept
+    {
+        m_buffer.append(s);
+        return *this;
+    }
+
+    StringBuilder& StringBuilder::append(char c) noexcept
+    {
+        m_buffer.push_back(c);
+        return *this;
+    }
+
+    StringBuilder& StringBuilder::appendLine(std::string_view s) noexcept
+    {
+        m_buffer.append(s);
+        m_buffer.push_back('\n');
+        return *this;
+    }
+
+    size_t StringBuilder::size() const noexcept
+    {
+        return m_buffer.size();
+    }
+
+    bool StringBuilder::empty() const noexcept
+    {
+        return m_buffer.empty();
+    }
+
+    size_t StringBuilder::capacity() const noexcept
+    {
+        return m_buffer.capacity();
+    }
+
+    void StringBuilder::reserve(size_t capacity) noexcept
+    {
+        m_buffer.reserve(capacity);
+    }
+
+    void StringBuilder::clear() noexcept
+    {
+        m_buffer.clear();
+    }
+
+    std::string_view StringBuilder::view() const noexcept
+    {
+        return m_buffer;
+    }
+
+    std::string StringBuilder::str() const noexcept
+    {
+        return m_buffer;
+    }
+
+    std::string StringBuilder::release() noexcept
+    {
+        std::string result{ std::move(m_buffer) };
+        m_buffer.clear();
+        return result;
+    }
+}
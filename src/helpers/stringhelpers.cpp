@@ -2,11 +2,10 @@
 #include <algorithm>
 #include <array>
 #include <cstdlib>
-#include <cwchar>
+#include <cstring>
 #include <locale>
 #include <limits>
-#include <regex>
-#include <sstream>
+#include "helpers/stringbuilder.h"
 #include "system/environment.h"
 #ifdef _WIN32
 #include <windows.h>
@@ -18,118 +17,355 @@ using namespace Nickvision::System;
 
 namespace Nickvision::Helpers
 {
-    std::vector<std::byte> StringHelpers::decode(const std::string& base64) noexcept
+    /**
+     * @brief Gets the lowercase version of an ASCII letter.
+     * @param c The character to convert
+     * @return The lowercase character, c if not an uppercase ASCII letter
+     */
+    static constexpr unsigned char asciiLower(unsigned char c) noexcept
     {
-        if(base64.empty() || base64.size() % 4 != 0)
+        return c >= 'A' && c <= 'Z' ? c | 0x20 : c;
+    }
+
+    /**
+     * @brief Flips the case of all ASCII letters in a range [first, last] of a string.
+     * @brief Eight bytes are checked at a time and non-ASCII bytes are left untouched.
+     * @param s The string to convert
+     * @param first The first letter to convert ('A' or 'a')
+     * @param last The last letter to convert ('Z' or 'z')
+     */
+    static void flipAsciiCase(std::string& s, unsigned char first, unsigned char last) noexcept
+    {
+        constexpr std::uint64_t ones{ 0x0101010101010101ull };
+        size_t i{ 0 };
+        for(; i + 8 <= s.size(); i += 8)
+        {
+            std::uint64_t chunk;
+            std::memcpy(&chunk, s.data() + i, 8);
+            //Adding to the low 7 bits of each byte sets its high bit when it reaches the bound, without carrying into the next byte
+            std::uint64_t heptets{ chunk & (0x7F * ones) };
+            std::uint64_t atLeastFirst{ heptets + (0x80 - first) * ones };
+            std::uint64_t pastLast{ heptets + (0x80 - last - 1) * ones };
+            std::uint64_t mask{ atLeastFirst & ~pastLast & ~chunk & (0x80 * ones) };
+            if(mask != 0)
+            {
+                chunk ^= mask >> 2;
+                std::memcpy(s.data() + i, &chunk, 8);
+            }
+        }
+        for(; i < s.size(); i++)
+        {
+            unsigned char c{ static_cast<unsigned char>(s[i]) };
+            if(c >= first && c <= last)
+            {
+                s[i] = static_cast<char>(c ^ 0x20);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets whether or not a character is ASCII whitespace.
+     * @param c The character to check
+     * @return True if whitespace, else false
+     */
+    static constexpr bool isAsciiSpace(char c) noexcept
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    int StringHelpers::compareIgnoreCase(std::string_view a, std::string_view b) noexcept
+    {
+        size_t size{ std::min(a.size(), b.size()) };
+        for(size_t i = 0; i < size; i++)
+        {
+            unsigned char ca{ asciiLower(static_cast<unsigned char>(a[i])) };
+            unsigned char cb{ asciiLower(static_cast<unsigned char>(b[i])) };
+            if(ca != cb)
+            {
+                return ca < cb ? -1 : 1;
+            }
+        }
+        return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+    }
+
+    std::vector<std::byte> StringHelpers::decode(std::string_view base64) noexcept
+    {
+        size_t size{ decodedSize(base64) };
+        if(size == 0)
+        {
+            return {};
+        }
+        std::vector<std::byte> bytes(size);
+        if(decode(base64, bytes) != size)
         {
             return {};
         }
-        static const unsigned char lookup[128]{ 
-        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255,  62, 255,  63,
-        52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
-        255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
-        15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255,  63,
-        255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
-        41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255 };
-        std::vector<std::byte> bytes;
-        bytes.reserve(3 * base64.size() / 4);
-        for(size_t i = 0; i < base64.size(); i += 4)
+        return bytes;
+    }
+
+    size_t StringHelpers::decode(std::string_view base64, std::span<std::byte> bytes) noexcept
+    {
+        static constexpr std::array<unsigned char, 256> lookup{ []()
         {
-            unsigned char b641{ base64[i] <= 122 ? lookup[static_cast<unsigned char>(base64[i])] : static_cast<unsigned char>(0xff) };
-            unsigned char b642{ base64[i + 1] <= 122 ? lookup[static_cast<unsigned char>(base64[i + 1])] : static_cast<unsigned char>(0xff) };
-            unsigned char b643{ base64[i + 2] <= 122 ? lookup[static_cast<unsigned char>(base64[i + 2])] : static_cast<unsigned char>(0xff) };
-            unsigned char b644{ base64[i + 3] <= 122 ? lookup[static_cast<unsigned char>(base64[i + 3])] : static_cast<unsigned char>(0xff) };
-            std::byte b1{ static_cast<unsigned char>(((b641 & 0x3f) << 2) + ((b642 & 0x30) >> 4)) };
-            std::byte b2{ static_cast<unsigned char>(((b642 & 0x0f) << 4) + ((b643 & 0x3c) >> 2)) };
-            std::byte b3{ static_cast<unsigned char>(((b643 & 0x03) << 6) + (b644 & 0x3f)) };
-            if(b642 != 0xff)
+            std::array<unsigned char, 256> table;
+            table.fill(0xff);
+            for(unsigned char i = 0; i < 26; i++)
             {
-                bytes.push_back(b1);
+                table['A' + i] = i;
+                table['a' + i] = 26 + i;
             }
-            if(b643 != 0xff)
+            for(unsigned char i = 0; i < 10; i++)
             {
-                bytes.push_back(b2);
+                table['0' + i] = 52 + i;
             }
-            if(b644 != 0xff)
+            table['+'] = 62;
+            table['-'] = 62;
+            table['/'] = 63;
+            table['_'] = 63;
+            return table;
+        }() };
+        size_t size{ decodedSize(base64) };
+        if(size == 0 || bytes.size() < size)
+        {
+            return 0;
+        }
+        const unsigned char* in{ reinterpret_cast<const unsigned char*>(base64.data()) };
+        unsigned char* out{ reinterpret_cast<unsigned char*>(bytes.data()) };
+        //Decode all full groups without branching, checking for invalid characters once at the end
+        size_t groups{ base64.size() / 4 - 1 };
+        unsigned char invalid{ 0 };
+        for(size_t i = 0; i < groups; i++, in += 4, out += 3)
+        {
+            unsigned char b641{ lookup[in[0]] };
+            unsigned char b642{ lookup[in[1]] };
+            unsigned char b643{ lookup[in[2]] };
+            unsigned char b644{ lookup[in[3]] };
+            invalid |= b641 | b642 | b643 | b644;
+            std::uint32_t value{ (static_cast<std::uint32_t>(b641) << 18) | (static_cast<std::uint32_t>(b642) << 12) | (static_cast<std::uint32_t>(b643) << 6) | b644 };
+            out[0] = static_cast<unsigned char>(value >> 16);
+            out[1] = static_cast<unsigned char>(value >> 8);
+            out[2] = static_cast<unsigned char>(value);
+        }
+        //Decode the final (possibly padded) group
+        size_t remaining{ size - groups * 3 };
+        unsigned char b641{ lookup[in[0]] };
+        unsigned char b642{ lookup[in[1]] };
+        unsigned char b643{ remaining > 1 ? lookup[in[2]] : static_cast<unsigned char>(0) };
+        unsigned char b644{ remaining > 2 ? lookup[in[3]] : static_cast<unsigned char>(0) };
+        invalid |= b641 | b642 | b643 | b644;
+        if(invalid & 0x80)
+        {
+            return 0;
+        }
+        std::uint32_t value{ (static_cast<std::uint32_t>(b641) << 18) | (static_cast<std::uint32_t>(b642) << 12) | (static_cast<std::uint32_t>(b643) << 6) | b644 };
+        out[0] = static_cast<unsigned char>(value >> 16);
+        if(remaining > 1)
+        {
+            out[1] = static_cast<unsigned char>(value >> 8);
+        }
+        if(remaining > 2)
+        {
+            out[2] = static_cast<unsigned char>(value);
+        }
+        return size;
+    }
+
+    size_t StringHelpers::decodedSize(std::string_view base64) noexcept
+    {
+        if(base64.empty() || base64.size() % 4 != 0)
+        {
+            return 0;
+        }
+        size_t padding{ 0 };
+        if(base64[base64.size() - 1] == '=')
+        {
+            padding++;
+            if(base64[base64.size() - 2] == '=')
             {
-                bytes.push_back(b3);
+                padding++;
             }
         }
-        return bytes;
+        return 3 * (base64.size() / 4) - padding;
     }
 
-    std::string StringHelpers::encode(const std::vector<std::byte>& bytes) noexcept
+    std::string StringHelpers::encode(std::span<const std::byte> bytes) noexcept
     {
         if(bytes.empty())
         {
             return "";
         }
-        static const char lookup[65]{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
-        size_t missing{ 0 };
-        size_t stringSize{ bytes.size() };
-        while((stringSize % 3) != 0)
+        std::string string(encodedSize(bytes.size()), '\0');
+        encode(bytes, string);
+        return string;
+    }
+
+    size_t StringHelpers::encode(std::span<const std::byte> bytes, std::span<char> base64) noexcept
+    {
+        static constexpr char lookup[65]{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
+        size_t size{ encodedSize(bytes.size()) };
+        if(base64.size() < size)
         {
-            stringSize++;
-            missing++;
+            return 0;
         }
-        stringSize = 4 * stringSize / 3;
-        std::string string;
-        string.reserve(stringSize);
-        for(size_t i = 0; i < stringSize / 4; i++)
+        const unsigned char* in{ reinterpret_cast<const unsigned char*>(bytes.data()) };
+        char* out{ base64.data() };
+        size_t groups{ bytes.size() / 3 };
+        for(size_t i = 0; i < groups; i++, in += 3, out += 4)
         {
-            size_t index{ i * 3 };
-            unsigned char b1{ index < bytes.size() ? static_cast<unsigned char>(bytes[index]) : static_cast<unsigned char>(0) };
-            unsigned char b2{ index + 1 < bytes.size() ? static_cast<unsigned char>(bytes[index + 1]) : static_cast<unsigned char>(0) };
-            unsigned char b3{ index + 2 < bytes.size() ? static_cast<unsigned char>(bytes[index + 2]) : static_cast<unsigned char>(0) };
-            unsigned char b641{ static_cast<unsigned char>((b1 & 0xfc) >> 2) };
-            unsigned char b642{ static_cast<unsigned char>(((b1 & 0x03) << 4) + ((b2 & 0xf0) >> 4)) };
-            unsigned char b643{ static_cast<unsigned char>(((b2 & 0x0f) << 2) + ((b3 & 0xc0) >> 6)) };
-            unsigned char b644{ static_cast<unsigned char>(b3 & 0x3f) };
-            string.push_back(lookup[b641]);
-            string.push_back(lookup[b642]);
-            string.push_back(lookup[b643]);
-            string.push_back(lookup[b644]);
+            std::uint32_t value{ (static_cast<std::uint32_t>(in[0]) << 16) | (static_cast<std::uint32_t>(in[1]) << 8) | in[2] };
+            out[0] = lookup[(value >> 18) & 0x3f];
+            out[1] = lookup[(value >> 12) & 0x3f];
+            out[2] = lookup[(value >> 6) & 0x3f];
+            out[3] = lookup[value & 0x3f];
         }
-        for(size_t i = 0; i != missing; i++)
+        size_t remaining{ bytes.size() - groups * 3 };
+        if(remaining > 0)
         {
-            string[stringSize - i - 1] = '=';
+            std::uint32_t value{ static_cast<std::uint32_t>(in[0]) << 16 };
+            if(remaining > 1)
+            {
+                value |= static_cast<std::uint32_t>(in[1]) << 8;
+            }
+            out[0] = lookup[(value >> 18) & 0x3f];
+            out[1] = lookup[(value >> 12) & 0x3f];
+            out[2] = remaining > 1 ? lookup[(value >> 6) & 0x3f] : '=';
+            out[3] = '=';
         }
-        return string;
+        return size;
     }
 
-    bool StringHelpers::isValidUrl(const std::string& s) noexcept
+    size_t StringHelpers::findIgnoreCase(std::string_view s, std::string_view find, size_t pos) noexcept
     {
-        if (s.empty())
+        if(pos > s.size() || find.size() > s.size() - pos)
+        {
+            return std::string_view::npos;
+        }
+        if(find.empty())
+        {
+            return pos;
+        }
+        unsigned char first{ asciiLower(static_cast<unsigned char>(find[0])) };
+        for(size_t i = pos; i <= s.size() - find.size(); i++)
+        {
+            if(asciiLower(static_cast<unsigned char>(s[i])) == first && compareIgnoreCase(s.substr(i + 1, find.size() - 1), find.substr(1)) == 0)
+            {
+                return i;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    bool StringHelpers::isValidUrl(std::string_view s) noexcept
+    {
+        //Linear time equivalent of: ^(http:\/\/www\.|https:\/\/www\.|http:\/\/|https:\/\/)?[a-z0-9]+([\-\.]{1}[a-z0-9]+)*\.[a-z]{2,5}(:[0-9]{1,5})?(\/.*)?$
+        //An optional "www." does not need special handling as it is also a valid host label
+        if(s.starts_with("http://"))
+        {
+            s.remove_prefix(7);
+        }
+        else if(s.starts_with("https://"))
+        {
+            s.remove_prefix(8);
+        }
+        //Host: labels separated by single '-' or '.', ending with a '.' and a 2-5 letter top level domain
+        size_t i{ 0 };
+        size_t labels{ 0 };
+        size_t labelStart{ 0 };
+        bool labelAlpha{ true };
+        char lastSeparator{ '\0' };
+        char separatorBeforeLabel{ '\0' };
+        for(; i < s.size(); i++)
+        {
+            char ch{ s[i] };
+            if((ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9'))
+            {
+                if(i == labelStart)
+                {
+                    labels++;
+                    labelAlpha = true;
+                    separatorBeforeLabel = lastSeparator;
+                }
+                labelAlpha = labelAlpha && ch >= 'a';
+            }
+            else if(ch == '-' || ch == '.')
+            {
+                if(i == labelStart)
+                {
+                    return false;
+                }
+                lastSeparator = ch;
+                labelStart = i + 1;
+            }
+            else
+            {
+                break;
+            }
+        }
+        size_t tldLength{ i - labelStart };
+        if(labels < 2 || tldLength == 0 || separatorBeforeLabel != '.' || !labelAlpha || tldLength < 2 || tldLength > 5)
+        {
+            return false;
+        }
+        //Port
+        if(i < s.size() && s[i] == ':')
+        {
+            size_t portStart{ ++i };
+            while(i < s.size() && s[i] >= '0' && s[i] <= '9')
+            {
+                i++;
+            }
+            if(i == portStart || i - portStart > 5)
+            {
+                return false;
+            }
+        }
+        //Path
+        if(i == s.size())
+        {
+            return true;
+        }
+        if(s[i] != '/')
         {
             return false;
         }
-        static std::regex urlRegex{ R"(^(http:\/\/www\.|https:\/\/www\.|http:\/\/|https:\/\/)?[a-z0-9]+([\-\.]{1}[a-z0-9]+)*\.[a-z]{2,5}(:[0-9]{1,5})?(\/.*)?$)" };
-        return std::regex_match(s, urlRegex);
+        return s.find_first_of("\r\n", i) == std::string_view::npos;
     }
 
     std::string StringHelpers::join(const std::vector<std::string>& values, const std::string& separator, bool separateLast) noexcept
     {
-        std::stringstream builder;
+        if(values.empty())
+        {
+            return "";
+        }
+        //Compute the exact size up front so the result is allocated once
+        size_t size{ separator.size() * (separateLast ? values.size() : values.size() - 1) };
+        for(const std::string& value : values)
+        {
+            size += value.size();
+        }
+        StringBuilder builder{ size };
         for(size_t i = 0; i < values.size(); i++)
         {
-            const std::string& value{ values[i] };
-            builder << value;
-            if(i != values.size() - 1 || (i == values.size() - 1 && separateLast))
+            builder.append(values[i]);
+            if(i != values.size() - 1 || separateLast)
             {
-                builder << separator;
+                builder.append(separator);
             }
         }
-        return builder.str();
+        return builder.release();
     }
 
     std::string StringHelpers::lower(std::string s) noexcept
     {
-        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+        lowerInPlace(s);
         return s;
     }
 
+    void StringHelpers::lowerInPlace(std::string& s) noexcept
+    {
+        flipAsciiCase(s, 'A', 'Z');
+    }
+
     std::string StringHelpers::newUuid() noexcept
     {
 #ifdef _WIN32
@@ -217,51 +453,140 @@ namespace Nickvision::Helpers
         return s;
     }
 
-    std::vector<std::string> StringHelpers::splitArgs(std::string s) noexcept
+    std::vector<std::string> StringHelpers::splitArgs(std::string_view s) noexcept
     {
+        //Linear time equivalent of repeatedly searching for: ((?:[^\s'"]+|"[^"]*"|'[^']*')+)
         std::vector<std::string> args;
-        std::regex regex{ "((?:[^\\s'\"]+|\"[^\"]*\"|'[^']*')+)" };
-        std::smatch match;
-        while (std::regex_search(s, match, regex))
+        bool unmatchedDouble{ false };
+        bool unmatchedSingle{ false };
+        size_t i{ 0 };
+        while(i < s.size())
         {
-            std::string arg{ match.str() };
-            if((arg[0] == '\'' && arg[arg.size() - 1] == '\'') || (arg[0] == '"' && arg[arg.size() - 1] == '"'))
+            size_t start{ i };
+            while(i < s.size() && !std::isspace(static_cast<unsigned char>(s[i])))
+            {
+                char ch{ s[i] };
+                if(ch == '"' || ch == '\'')
+                {
+                    //Once a quote has no closing quote, no later quote of the same kind can have one either
+                    bool& unmatched{ ch == '"' ? unmatchedDouble : unmatchedSingle };
+                    size_t close{ unmatched ? std::string_view::npos : s.find(ch, i + 1) };
+                    if(close == std::string_view::npos)
+                    {
+                        unmatched = true;
+                        break;
+                    }
+                    i = close + 1;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+            //Skip whitespace and unmatched quotes
+            if(i == start)
+            {
+                i++;
+                continue;
+            }
+            std::string_view arg{ s.substr(start, i - start) };
+            if(arg.size() > 1 && (arg.front() == '\'' || arg.front() == '"') && arg.front() == arg.back())
             {
                 arg = arg.substr(1, arg.size() - 2);
             }
-            args.push_back(arg);
-            s = match.suffix();
-        }
-        if(!s.empty())
-        {
-            args.push_back(s);
+            args.emplace_back(arg);
         }
         return args;
     }
 
-    std::string StringHelpers::str(const std::wstring& s) noexcept
+    std::string StringHelpers::str(std::wstring_view s) noexcept
     {
-#ifdef _WIN32
-        int size{ WideCharToMultiByte(CP_UTF8, 0, s.c_str(), -1, nullptr, 0, nullptr, nullptr) };
-        if(size <= 0)
+        if(s.empty())
         {
             return {};
         }
-        std::string res(size - 1, 0);
-        WideCharToMultiByte(CP_UTF8, 0, s.c_str(), -1, &res[0], size, nullptr, nullptr);
-        return res;
-#else
-        std::mbstate_t state{};
-        const wchar_t* ptr{ s.data() };
-        size_t size{ 1 + std::wcsrtombs(nullptr, &ptr, 0, &state) };
-        if(size == static_cast<std::size_t>(-1))
+        //Size the result exactly, assuming valid input (validated during conversion)
+        size_t size{ 0 };
+        for(wchar_t ch : s)
+        {
+            std::uint32_t unit{ static_cast<std::make_unsigned_t<wchar_t>>(ch) };
+            size += unit < 0x80 ? 1 : unit < 0x800 ? 2 : (unit >= 0xD800 && unit <= 0xDFFF && sizeof(wchar_t) == 2) ? 2 : unit < 0x10000 ? 3 : 4;
+        }
+        std::string res(size, '\0');
+        if(str(s, res) != size)
         {
             return {};
         }
-        std::vector<char> buf(size);
-        std::wcsrtombs(buf.data(), &ptr, buf.size(), &state);
-        return std::string(buf.data());
-#endif
+        return res;
+    }
+
+    size_t StringHelpers::str(std::wstring_view s, std::span<char> out) noexcept
+    {
+        size_t written{ 0 };
+        size_t i{ 0 };
+        while(i < s.size())
+        {
+            //ASCII fast path
+            while(i < s.size() && written < out.size() && static_cast<std::make_unsigned_t<wchar_t>>(s[i]) < 0x80)
+            {
+                out[written++] = static_cast<char>(s[i++]);
+            }
+            if(i == s.size())
+            {
+                break;
+            }
+            std::uint32_t codepoint{ static_cast<std::make_unsigned_t<wchar_t>>(s[i++]) };
+            if constexpr(sizeof(wchar_t) == 2)
+            {
+                if(codepoint >= 0xD800 && codepoint <= 0xDBFF)
+                {
+                    std::uint32_t low{ i < s.size() ? static_cast<std::make_unsigned_t<wchar_t>>(s[i]) : 0u };
+                    if(low < 0xDC00 || low > 0xDFFF)
+                    {
+                        return 0;
+                    }
+                    i++;
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                else if(codepoint >= 0xDC00 && codepoint <= 0xDFFF)
+                {
+                    return 0;
+                }
+            }
+            else if(codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+            {
+                return 0;
+            }
+            size_t length{ codepoint < 0x80 ? 1u : codepoint < 0x800 ? 2u : codepoint < 0x10000 ? 3u : 4u };
+            if(written + length > out.size())
+            {
+                return 0;
+            }
+            char* o{ out.data() + written };
+            switch(length)
+            {
+            case 1:
+                o[0] = static_cast<char>(codepoint);
+                break;
+            case 2:
+                o[0] = static_cast<char>(0xC0 | (codepoint >> 6));
+                o[1] = static_cast<char>(0x80 | (codepoint & 0x3F));
+                break;
+            case 3:
+                o[0] = static_cast<char>(0xE0 | (codepoint >> 12));
+                o[1] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                o[2] = static_cast<char>(0x80 | (codepoint & 0x3F));
+                break;
+            default:
+                o[0] = static_cast<char>(0xF0 | (codepoint >> 18));
+                o[1] = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+                o[2] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                o[3] = static_cast<char>(0x80 | (codepoint & 0x3F));
+                break;
+            }
+            written += length;
+        }
+        return written;
     }
 
     unsigned int StringHelpers::stoui(const std::string& s, size_t* idx, int base) noexcept
@@ -283,68 +608,276 @@ namespace Nickvision::Helpers
 
     std::string StringHelpers::trim(const std::string& s) noexcept
     {
-        if(s.empty())
-        {
-            return s;
-        }
-        std::string result{ s };
-        result.erase(std::find_if(result.rbegin(), result.rend(), [](unsigned char ch) 
-        {
-            return !std::isspace(ch);
-        }).base(), result.end());
-        result.erase(result.begin(), std::find_if(result.begin(), result.end(), [](unsigned char ch)
-        {
-            return !std::isspace(ch);
-        }));
-        return result;
+        return std::string{ trimView(s) };
     }
 
     std::string StringHelpers::trim(const std::string& s, char delimiter) noexcept
     {
-        if(s.empty())
+        return std::string{ trimView(s, delimiter) };
+    }
+
+    std::string_view StringHelpers::trimView(std::string_view s) noexcept
+    {
+        size_t start{ 0 };
+        size_t end{ s.size() };
+        while(start < end && isAsciiSpace(s[start]))
         {
-            return s;
+            start++;
         }
-        std::string result{ s };
-        result.erase(std::find_if(result.rbegin(), result.rend(), [delimiter](char ch)
+        while(end > start && isAsciiSpace(s[end - 1]))
         {
-            return ch != delimiter;
-        }).base(), result.end());
-        result.erase(result.begin(), std::find_if(result.begin(), result.end(), [delimiter](char ch)
+            end--;
+        }
+        return s.substr(start, end - start);
+    }
+
+    std::string_view StringHelpers::trimView(std::string_view s, char delimiter) noexcept
+    {
+        size_t start{ s.find_first_not_of(delimiter) };
+        if(start == std::string_view::npos)
         {
-                return ch != delimiter;
-        }));
-        return result;
+            return {};
+        }
+        return s.substr(start, s.find_last_not_of(delimiter) - start + 1);
     }
 
     std::string StringHelpers::upper(std::string s) noexcept
     {
-        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::toupper(c); });
+        upperInPlace(s);
         return s;
     }
 
-    std::wstring StringHelpers::wstr(const std::string& s) noexcept
+    void StringHelpers::upperInPlace(std::string& s) noexcept
     {
-#ifdef _WIN32
-        int size{ MultiByteToWideChar(CP_UTF8, 0, s.c_str(), -1, nullptr, 0) };
-        if(size <= 0)
+        flipAsciiCase(s, 'a', 'z');
+    }
+
+    std::wstring StringHelpers::wstr(std::string_view s) noexcept
+    {
+        if(s.empty())
         {
             return {};
         }
-        std::wstring res(size - 1, 0);
-        MultiByteToWideChar(CP_UTF8, 0, s.c_str(), -1, &res[0], size);
-        return res;
-#else
-        std::mbstate_t state{};
-        const char* ptr{ s.data() };
-        size_t size{ 1 + std::mbsrtowcs(nullptr, &ptr, 0, &state) };
-        if(size == static_cast<std::size_t>(-1))
+        //A UTF-8 string never has fewer bytes than its wide version has characters
+        std::wstring res(s.size(), L'\0');
+        size_t size{ wstr(s, res) };
+        if(size == 0)
         {
             return {};
         }
-        std::vector<wchar_t> buf(size);
-        std::mbsrtowcs(buf.data(), &ptr, buf.size(), &state);
-        return std::wstring(buf.data());
-#endif
+        res.resize(size);
+        return res;
+    }
+
+    size_t StringHelpers::wstr(std::string_view s, std::span<wchar_t> out) noexcept
+    {
+        const unsigned char* in{ reinterpret_cast<const unsigned char*>(s.data()) };
+        size_t written{ 0 };
+        size_t i{ 0 };
+        while(i < s.size())
+        {
+            //ASCII fast path, 8 bytes at a time
+            while(i + 8 <= s.size() && written + 8 <= out.size())
+            {
+                std::uint64_t block;
+                std::memcpy(&block, in + i, sizeof(block));
+                if(block & 0x8080808080808080ull)
+                {
+                    break;
+                }
+                for(size_t j = 0; j < 8; j++)
+                {
+                    out[written + j] = static_cast<wchar_t>(in[i + j]);
+                }
+                i += 8;
+                written += 8;
+            }
+            if(i == s.size())
+            {
+                break;
+            }
+            std::uint32_t lead{ in[i] };
+            std::uint32_t codepoint;
+            std::uint32_t minimum;
+            size_t length;
+            if(lead < 0x80)
+            {
+                codepoint = lead;
+                minimum = 0;
+                length = 1;
+            }
+            else if((lead & 0xE0) == 0xC0)
+            {
+                codepoint = lead & 0x1F;
+                minimum = 0x80;
+                length = 2;
+            }
+            else if((lead & 0xF0) == 0xE0)
+            {
+                codepoint = lead & 0x0F;
+                minimum = 0x800;
+                length = 3;
+            }
+            else if((lead & 0xF8) == 0xF0)
+            {
+                codepoint = lead & 0x07;
+                minimum = 0x10000;
+                length = 4;
+            }
+            else
+            {
+                return 0;
+            }
+            if(i + length > s.size())
+            {
+                return 0;
+            }
+            for(size_t j = 1; j < length; j++)
+            {
+                if((in[i + j] & 0xC0) != 0x80)
+                {
+                    return 0;
+                }
+                codepoint = (codepoint << 6) | (in[i + j] & 0x3F);
+            }
+            //Reject overlong encodings, surrogates and out of range codepoints
+            if(codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+            {
+                return 0;
+            }
+            i += length;
+            if(sizeof(wchar_t) == 2 && codepoint >= 0x10000)
+            {
+                if(written + 2 > out.size())
+                {
+                    return 0;
+                }
+                out[written++] = static_cast<wchar_t>(0xD800 + ((codepoint - 0x10000) >> 10));
+                out[written++] = static_cast<wchar_t>(0xDC00 + ((codepoint - 0x10000) & 0x3FF));
+            }
+            else
+            {
+                if(written == out.size())
+                {
+                    return 0;
+                }
+                out[written++] = static_cast<wchar_t>(codepoint);
+            }
+        }
+        return written;
+    }
+
+    StringHelpers::SplitView::Iterator::Iterator() noexcept
+        : m_view{ nullptr },
+        m_next{ std::string_view::npos }
+    {
+
+    }
+
+    StringHelpers::SplitView::Iterator::Iterator(const SplitView* view) noexcept
+        : m_view{ view },
+        m_next{ 0 }
+    {
+        next();
+    }
+
+    StringHelpers::SplitView::Iterator::reference StringHelpers::SplitView::Iterator::operator*() const noexcept
+    {
+        return m_token;
+    }
+
+    StringHelpers::SplitView::Iterator::pointer StringHelpers::SplitView::Iterator::operator->() const noexcept
+    {
+        return &m_token;
+    }
+
+    StringHelpers::SplitView::Iterator& StringHelpers::SplitView::Iterator::operator++() noexcept
+    {
+        next();
+        return *this;
+    }
+
+    StringHelpers::SplitView::Iterator StringHelpers::SplitView::Iterator::operator++(int) noexcept
+    {
+        Iterator copy{ *this };
+        next();
+        return copy;
+    }
+
+    bool StringHelpers::SplitView::Iterator::operator==(const Iterator& other) const noexcept
+    {
+        return m_view == other.m_view && m_token.data() == other.m_token.data();
+    }
+
+    void StringHelpers::SplitView::Iterator::next() noexcept
+    {
+        while(m_view)
+        {
+            //The final token has already been produced
+            if(m_next == std::string_view::npos)
+            {
+                m_view = nullptr;
+                m_token = {};
+                return;
+            }
+            size_t found{ m_view->find(m_next) };
+            if(found == std::string_view::npos)
+            {
+                m_token = m_view->m_string.substr(m_next);
+                m_next = std::string_view::npos;
+            }
+            else
+            {
+                m_token = m_view->m_string.substr(m_next, found - m_next);
+                m_next = found + m_view->m_delimiterLength;
+            }
+            if(m_view->m_includeEmpty || std::find_if(m_token.begin(), m_token.end(), [](unsigned char ch) { return !std::isspace(ch); }) != m_token.end())
+            {
+                return;
+            }
+        }
+    }
+
+    StringHelpers::SplitView::SplitView(std::string_view s, std::string_view delimiter, bool includeEmpty) noexcept
+        : m_string{ s },
+        m_delimiter{ delimiter },
+        m_delimiterLength{ delimiter.size() },
+        m_delimiterChar{ delimiter.size() == 1 ? delimiter[0] : '\0' },
+        m_includeEmpty{ includeEmpty }
+    {
+
+    }
+
+    StringHelpers::SplitView::SplitView(std::string_view s, char delimiter, bool includeEmpty) noexcept
+        : m_string{ s },
+        m_delimiterLength{ 1 },
+        m_delimiterChar{ delimiter },
+        m_includeEmpty{ includeEmpty }
+    {
+
+    }
+
+    StringHelpers::SplitView::Iterator StringHelpers::SplitView::begin() const noexcept
+    {
+        return { this };
+    }
+
+    StringHelpers::SplitView::Iterator StringHelpers::SplitView::end() const noexcept
+    {
+        return {};
+    }
+
+    size_t StringHelpers::SplitView::find(size_t pos) const noexcept
+    {
+        if(m_delimiterLength == 0)
+        {
+            return std::string_view::npos;
+        }
+        else if(m_delimiterLength == 1)
+        {
+            //Single character search uses memchr
+            return m_string.find(m_delimiterChar, pos);
+        }
+        return m_string.find(m_delimiter, pos);
     }
 }
@@ -39,10 +39,14 @@ namespace Nickvision::Keyring
                     {
                         m_database.reset();
                     }
-                    SqliteStatement statement{ m_database->createStatement("SELECT * FROM credentials") };
-                    while(statement.step() != SqliteStepResult::Done)
+                    else
                     {
-                        m_credentials.push_back({ statement.getColumn<std::string>(0), statement.getColumn<std::string>(1), statement.getColumn<std::string>(2), statement.getColumn<std::string>(3) });
+                        using CredentialRow = std::tuple<std::string, std::string, std::string, std::string>;
+                        SqliteStatement statement{ m_database->createStatement("SELECT name, uri, username, password FROM credentials") };
+                        for(const CredentialRow& row : statement.rows<CredentialRow>())
+                        {
+                            m_credentials.push_back(std::make_from_tuple<Credential>(row));
+                        }
                     }
                 }
                 else // New Keyring
@@ -1,11 +1,11 @@
 #include "system/environment.h"
 #include <cstdlib>
 #include <locale>
-#include <sstream>
 #include <unordered_map>
 #include <utility>
 #include "filesystem/userdirectories.h"
 #include "helpers/pairhash.h"
+#include "helpers/stringbuilder.h"
 #include "helpers/stringhelpers.h"
 #include "system/process.h"
 #ifdef _WIN32
@@ -176,25 +176,21 @@ namespace Nickvision::System
             dependency += ".exe";
         }
 #endif
-        std::pair<std::string, DependencySearchOption> pair{ std::make_pair(dependency, search) };
-        //Dependency already found once before
-        if(dependencies.contains(pair))
+        //Hash the key once, the entry is updated in place below
+        std::filesystem::path& location{ dependencies[std::make_pair(dependency, search)] };
+        //Dependency already found once before, return if path is still valid
+        if(!location.empty() && std::filesystem::exists(location))
         {
-            const std::filesystem::path& location{ dependencies[pair] };
-            //Return if path is still valid
-            if(std::filesystem::exists(location))
-            {
-                return location;
-            }
+            return location;
         }
         //Search for dependency
-        dependencies[pair] = std::filesystem::path();
+        location.clear();
         if(search == DependencySearchOption::Global) //Executable directory, than PATH
         {
             std::filesystem::path path{ getExecutableDirectory() / dependency };
             if(std::filesystem::exists(path))
             {
-                dependencies[pair] = path;
+                location = path;
             }
             else
             {
@@ -203,7 +199,7 @@ namespace Nickvision::System
                     path = { dir / dependency };
                     if(std::filesystem::exists(path) && dir.string().find("AppData\\Local\\Microsoft\\WindowsApps") == std::string::npos)
                     {
-                        dependencies[pair] = path;
+                        location = path;
                         break;
                     }
                 }
@@ -214,7 +210,7 @@ namespace Nickvision::System
             std::filesystem::path path{ getExecutableDirectory() / dependency };
             if(std::filesystem::exists(path))
             {
-                dependencies[pair] = path;
+                location = path;
             }
         }
         else if(search == DependencySearchOption::System) //PATH only
@@ -225,7 +221,7 @@ namespace Nickvision::System
                 path = { dir / dependency };
                 if(std::filesystem::exists(path) && dir.string().find("AppData\\Local\\Microsoft\\WindowsApps") == std::string::npos)
                 {
-                    dependencies[pair] = path;
+                    location = path;
                     break;
                 }
             }
@@ -235,51 +231,51 @@ namespace Nickvision::System
             std::filesystem::path path{ UserDirectories::get(UserDirectory::LocalData) / dependency };
             if(std::filesystem::exists(path))
             {
-                dependencies[pair] = path;
+                location = path;
             }
         }
-        return dependencies[pair];
+        return location;
     }
 
     std::string Environment::getDebugInformation(const AppInfo& appInfo, const std::string& extraInformation) noexcept
     {
-        std::stringstream builder;
-        builder << appInfo.getId() << std::endl;
+        StringBuilder builder{ 256 + extraInformation.size() };
+        builder.appendLine(appInfo.getId());
         switch(getOperatingSystem())
         {
         case OperatingSystem::Windows:
-            builder << "Windows" << std::endl;
+            builder.appendLine("Windows");
             break;
         case OperatingSystem::MacOS:
-            builder << "macOS" << std::endl;
+            builder.appendLine("macOS");
             break;
         case OperatingSystem::Linux:
-            builder << "Linux" << std::endl;
+            builder.appendLine("Linux");
             break;
         default:
-            builder << "Unknown OS" << std::endl;
+            builder.appendLine("Unknown OS");
             break;
         }
-        builder << appInfo.getVersion().str() << std::endl << std::endl;
-        builder << "Deployment Mode: ";
+        builder.appendLine(appInfo.getVersion().str()).appendLine();
+        builder.append("Deployment Mode: ");
         switch(getDeploymentMode())
         {
         case DeploymentMode::Local:
-            builder << "Local" << std::endl;
+            builder.appendLine("Local");
             break;
         case DeploymentMode::Flatpak:
-            builder << "Flatpak" << std::endl;
+            builder.appendLine("Flatpak");
             break;
         case DeploymentMode::Snap:
-            builder << "Snap" << std::endl;
+            builder.appendLine("Snap");
             break;
         }
-        builder << "Locale: " << getLocaleName() << std::endl;
-        builder << "Running From: " << getExecutableDirectory() << std::endl;
+        builder.append("Locale: ").appendLine(getLocaleName());
+        builder.appendFormat("Running From: \"{}\"\n", getExecutableDirectory().string());
         if(!extraInformation.empty())
         {
-            builder << std::endl << extraInformation;
+            builder.appendLine().append(extraInformation);
         }
-        return builder.str();
+        return builder.release();
     }
 }
@@ -233,15 +233,35 @@ namespace Nickvision::System
             std::string line;
             //Proc information
             std::getline(proc, line);
-            std::vector<std::string> procTokens{ StringHelpers::split(line, ' ', false) };
-            unsigned long long userTime{ std::stoull(procTokens[13]) + std::stoull(procTokens[14]) };
+            unsigned long long userTime{ 0 };
+            int index{ 0 };
+            for(std::string_view token : StringHelpers::SplitView{ line, ' ', false })
+            {
+                if(index == 13 || index == 14)
+                {
+                    userTime += std::stoull(std::string(token));
+                }
+                else if(index > 14)
+                {
+                    break;
+                }
+                index++;
+            }
             //Sys information
             std::getline(stat, line);
-            std::vector<std::string> statTokens{ StringHelpers::split(line, ' ', false) };
             unsigned long long systemTime{ 0 };
-            for(int i = 1; i < 9; i++)
+            index = 0;
+            for(std::string_view token : StringHelpers::SplitView{ line, ' ', false })
             {
-                systemTime += std::stoull(statTokens[i]);
+                if(index >= 1 && index < 9)
+                {
+                    systemTime += std::stoull(std::string(token));
+                }
+                else if(index >= 9)
+                {
+                    break;
+                }
+                index++;
             }
             //Get usage
             unsigned long long sysDelta{ systemTime - m_lastSystemTime };
@@ -320,8 +340,13 @@ namespace Nickvision::System
             {
                 if(line.find("VmRSS:") != std::string::npos)
                 {
-                    std::vector<std::string> fields{ StringHelpers::split(line, ' ', false) };
-                    return SizeHelpers::kilobytesToBytes(std::stoull(fields[1]));
+                    StringHelpers::SplitView fields{ line, ' ', false };
+                    StringHelpers::SplitView::Iterator value{ ++fields.begin() };
+                    if(value != fields.end())
+                    {
+                        return SizeHelpers::kilobytesToBytes(std::stoull(std::string(*value)));
+                    }
+                    break;
                 }
             }
         }
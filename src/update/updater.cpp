@@ -140,8 +140,8 @@ namespace Nickvision::Update
             {
                 return false;
             }
-            std::string name{ nameValue.as_string() };
-            if ((exactMatch && StringHelpers::lower(name) == StringHelpers::lower(assetName)) || (!exactMatch && StringHelpers::lower(name).find(StringHelpers::lower(assetName)) != std::string::npos))
+            std::string_view name{ nameValue.as_string() };
+            if ((exactMatch && StringHelpers::compareIgnoreCase(name, assetName) == 0) || (!exactMatch && StringHelpers::findIgnoreCase(name, assetName) != std::string::npos))
             {
                 const boost::json::value& urlValue{ assetObject["browser_download_url"] };
                 if (urlValue.is_string() && Web::downloadFile(urlValue.as_string().c_str(), path, progress))
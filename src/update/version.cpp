@@ -43,33 +43,33 @@ namespace Nickvision::Update
         m_build{ 0 }
     {
 
-        std::vector<std::string> splits{ StringHelpers::split(version, ".", false) };
+        std::vector<std::string_view> splits{ StringHelpers::split<std::string_view>(version, '.', false) };
         if(splits.size() < 3)
         {
             throw std::invalid_argument("Ill-formated version string.");
         }
-        m_major = std::stoi(splits[0]);
-        m_minor = std::stoi(splits[1]);
+        m_major = std::stoi(std::string(splits[0]));
+        m_minor = std::stoi(std::string(splits[1]));
         if(splits.size() == 3)
         {
             if(splits[2].find("-") == std::string::npos)
             {
-                m_build = std::stoi(splits[2]);
+                m_build = std::stoi(std::string(splits[2]));
             }
             else
             {
-                std::vector<std::string> devSplits{ StringHelpers::split(splits[2], "-", false) };
+                std::vector<std::string_view> devSplits{ StringHelpers::split<std::string_view>(splits[2], '-', false) };
                 if(devSplits.size() != 2)
                 {
                     throw std::invalid_argument("Ill-formated version string.");
                 }
-                m_build = std::stoi(devSplits[0]);
+                m_build = std::stoi(std::string(devSplits[0]));
                 m_dev = devSplits[1];
             }
         }
         else if(splits.size() == 4)
         {
-            m_build = std::stoi(splits[2]);
+            m_build = std::stoi(std::string(splits[2]));
             m_dev = splits[3];
         }
         else
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include "filesystem/atomicfilewriter.h"
+#include "filesystem/directoryscanner.h"
+
+using namespace Nickvision::Filesystem;
+
+static std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream in{ path, std::ios::binary };
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+class AtomicFileWriterTest : public testing::Test
+{
+public:
+    static std::filesystem::path m_directory;
+
+    static void SetUpTestSuite()
+    {
+        std::filesystem::create_directories(m_directory);
+        std::ofstream{ m_directory / "file.txt" } << "old";
+    }
+
+    static void TearDownTestSuite()
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+};
+
+std::filesystem::path AtomicFileWriterTest::m_directory{ "atomicwritertest" };
+
+TEST_F(AtomicFileWriterTest, Discard)
+{
+    {
+        AtomicFileWriter writer{ m_directory / "file.txt" };
+        ASSERT_TRUE(writer.write("new"));
+    }
+    ASSERT_EQ(readFile(m_directory / "file.txt"), "old");
+    ASSERT_EQ(DirectoryScanner::scan(m_directory).size(), 1);
+}
+
+TEST_F(AtomicFileWriterTest, Commit)
+{
+    std::string large(200 * 1024, 'x');
+    AtomicFileWriter writer{ m_directory / "file.txt", false };
+    ASSERT_TRUE(writer.write("new"));
+    ASSERT_TRUE(writer.write(large));
+    ASSERT_EQ(readFile(m_directory / "file.txt"), "old");
+    ASSERT_TRUE(writer.commit());
+    ASSERT_FALSE(writer.write("more"));
+    ASSERT_EQ(readFile(m_directory / "file.txt"), "new" + large);
+    ASSERT_EQ(DirectoryScanner::scan(m_directory).size(), 1);
+}
+
+TEST_F(AtomicFileWriterTest, Vectored)
+{
+    std::string a{ "abc" };
+    std::string b(100 * 1024, 'y');
+    std::span<const std::byte> buffers[]{ std::as_bytes(std::span{ a }), {}, std::as_bytes(std::span{ b }), std::as_bytes(std::span{ a }) };
+    AtomicFileWriter writer{ m_directory / "vectored.txt" };
+    ASSERT_TRUE(writer.write("start"));
+    ASSERT_TRUE(writer.write(std::span<const std::span<const std::byte>>{ buffers }));
+    ASSERT_TRUE(writer.commit());
+    ASSERT_EQ(readFile(m_directory / "vectored.txt"), "start" + a + b + a);
+}
+
+#ifndef _WIN32
+TEST_F(AtomicFileWriterTest, Symlink)
+{
+    std::ofstream{ m_directory / "target.txt" } << "old";
+    std::filesystem::create_symlink("target.txt", m_directory / "link.txt");
+    AtomicFileWriter writer{ m_directory / "link.txt" };
+    ASSERT_EQ(writer.getPath(), m_directory / "target.txt");
+    ASSERT_TRUE(writer.write("new"));
+    ASSERT_TRUE(writer.commit());
+    ASSERT_TRUE(std::filesystem::is_symlink(m_directory / "link.txt"));
+    ASSERT_EQ(readFile(m_directory / "target.txt"), "new");
+}
+#endif
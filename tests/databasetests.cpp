@@ -1,9 +1,21 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <ranges>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "database/asyncsqlitedatabase.h"
+#include "database/sqliteconnectionpool.h"
 #include "database/sqlitedatabase.h"
 
 using namespace Nickvision::Database;
+using namespace Nickvision::Events;
+using namespace Nickvision::Helpers;
 
 class Person
 {
@@ -120,4 +132,563 @@ TEST_F(DatabaseTest, GetPerson2)
     ASSERT_EQ(statement.getColumn<std::string>(1), getPerson2().getName());
     ASSERT_EQ(statement.getColumn<int>(2), getPerson2().getAge());
     ASSERT_EQ(statement.step(), SqliteStepResult::Done);
-}
\ No newline at end of file
+}
+TEST_F(DatabaseTest, StatementCache)
+{
+    std::filesystem::path path{ "cache.sqlite3" };
+    std::filesystem::remove(path);
+    {
+        SqliteDatabase database{ path };
+        ASSERT_TRUE(database.execute("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT)"));
+        ASSERT_EQ(database.getStatementCacheCapacity(), 32);
+        for(int i = 0; i < 10; i++)
+        {
+            SqliteStatement statement{ database.createStatement("INSERT INTO items (name) VALUES (?)") };
+            ASSERT_TRUE(statement.bind(1, std::to_string(i)));
+            ASSERT_EQ(statement.step(), SqliteStepResult::Done);
+        }
+        ASSERT_EQ(database.getStatementCacheMisses(), 1);
+        ASSERT_EQ(database.getStatementCacheHits(), 9);
+        {
+            //A statement in use is not handed out twice
+            SqliteStatement first{ database.createStatement("SELECT count(*) FROM items") };
+            SqliteStatement second{ database.createStatement("SELECT count(*) FROM items") };
+            ASSERT_EQ(first.step(), SqliteStepResult::Row);
+            ASSERT_EQ(second.step(), SqliteStepResult::Row);
+            ASSERT_EQ(first.getColumn<int>(0), 10);
+            ASSERT_EQ(second.getColumn<int>(0), 10);
+        }
+        {
+            //A cached statement is reset when returned
+            SqliteStatement statement{ database.createStatement("SELECT count(*) FROM items") };
+            ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+            ASSERT_EQ(statement.getColumn<int>(0), 10);
+        }
+        ASSERT_EQ(database.getStatementCacheHits(), 10);
+        //Statements are cached by their whole command, including text sqlite3_sql() drops after the first statement
+        for(const std::string& command : { std::string{ "SELECT count(*) FROM items;\n" }, std::string{ "SELECT 1; SELECT 2;" } })
+        {
+            for(int i = 0; i < 3; i++)
+            {
+                SqliteStatement statement{ database.createStatement(command) };
+                ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+            }
+        }
+        ASSERT_EQ(database.getStatementCacheHits(), 14);
+        ASSERT_EQ(database.getStatementCacheMisses(), 5);
+        database.setStatementCacheCapacity(0);
+        ASSERT_EQ(database.getStatementCacheCapacity(), 0);
+        for(int i = 0; i < 2; i++)
+        {
+            SqliteStatement statement{ database.createStatement("SELECT count(*) FROM items") };
+            ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+        }
+        ASSERT_EQ(database.getStatementCacheHits(), 14);
+        ASSERT_EQ(database.getStatementCacheMisses(), 7);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_F(DatabaseTest, Transactions)
+{
+    std::filesystem::path path{ "transactions.sqlite3" };
+    std::filesystem::remove(path);
+    {
+        SqliteDatabase database{ path };
+        ASSERT_TRUE(database.execute("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT, price REAL)"));
+        std::function<int()> count{ [&database]()
+        {
+            SqliteStatement statement{ database.createStatement("SELECT count(*) FROM items") };
+            statement.step();
+            return statement.getColumn<int>(0);
+        } };
+        {
+            SqliteTransaction transaction{ database, SqliteTransactionType::Immediate };
+            ASSERT_TRUE(database.execute("INSERT INTO items (name, price) VALUES ('a', 1.0)"));
+            ASSERT_THROW(SqliteTransaction{ database }, std::runtime_error);
+            {
+                SqliteSavepoint savepoint{ database };
+                ASSERT_TRUE(database.execute("INSERT INTO items (name, price) VALUES ('b', 2.0)"));
+                ASSERT_TRUE(savepoint.rollback());
+                ASSERT_FALSE(savepoint.isActive());
+            }
+            {
+                SqliteSavepoint savepoint{ database };
+                ASSERT_TRUE(database.execute("INSERT INTO items (name, price) VALUES ('c', 3.0)"));
+                ASSERT_TRUE(savepoint.release());
+            }
+            ASSERT_TRUE(transaction.commit());
+            ASSERT_FALSE(transaction.isActive());
+        }
+        ASSERT_EQ(count(), 2);
+        //Rolled back when an exception leaves the scope
+        ASSERT_THROW(
+        {
+            SqliteTransaction transaction{ database };
+            database.execute("INSERT INTO items (name, price) VALUES ('d', 4.0)");
+            throw std::runtime_error("Failed.");
+        }, std::runtime_error);
+        ASSERT_EQ(count(), 2);
+        std::vector<std::tuple<std::string, double>> rows;
+        for(int i = 0; i < 1000; i++)
+        {
+            rows.emplace_back(std::to_string(i), i * 0.5);
+        }
+        ASSERT_TRUE(database.bulkInsert("INSERT INTO items (name, price) VALUES (?, ?)", rows));
+        ASSERT_EQ(count(), 1002);
+        std::vector<Person> people{ getPerson1(), getPerson2() };
+        ASSERT_TRUE(database.bulkInsert("INSERT INTO items (name, price) VALUES (?, ?)", people, [](SqliteStatement& statement, const Person& person)
+        {
+            return statement.bind(1, person.getName()) && statement.bind(2, static_cast<double>(person.getAge()));
+        }));
+        ASSERT_EQ(count(), 1004);
+        //A failing row rolls back the whole insert
+        ASSERT_FALSE(database.bulkInsert("INSERT INTO items (id, name, price) VALUES (?, ?, ?)", std::vector<std::tuple<int, std::string, double>>{ { 5000, "x", 1.0 }, { 5000, "y", 2.0 } }));
+        ASSERT_EQ(count(), 1004);
+        //Other threads wait for an active transaction instead of joining it
+        std::atomic<bool> inserted{ false };
+        std::thread other;
+        {
+            SqliteTransaction transaction{ database };
+            ASSERT_TRUE(database.execute("INSERT INTO items (name, price) VALUES ('e', 5.0)"));
+            other = std::thread([&database, &inserted]()
+            {
+                inserted = database.execute("INSERT INTO items (name, price) VALUES ('f', 6.0)");
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            ASSERT_FALSE(inserted);
+            ASSERT_TRUE(transaction.rollback());
+        }
+        other.join();
+        ASSERT_TRUE(inserted);
+        ASSERT_EQ(count(), 1005);
+        //This includes statements created before the transaction began
+        inserted = false;
+        SqliteStatement prepared{ database.createStatement("INSERT INTO items (name, price) VALUES ('g', 7.0)") };
+        {
+            SqliteTransaction transaction{ database };
+            other = std::thread([&prepared, &inserted]()
+            {
+                inserted = prepared.step() == SqliteStepResult::Done;
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            ASSERT_FALSE(inserted);
+            ASSERT_TRUE(transaction.rollback());
+        }
+        other.join();
+        ASSERT_TRUE(inserted);
+        ASSERT_EQ(count(), 1006);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_F(DatabaseTest, ConnectionPool)
+{
+    std::filesystem::path path{ "pool.sqlite3" };
+    std::filesystem::remove(path);
+    {
+        ASSERT_THROW(SqliteConnectionPool(path, 0), std::invalid_argument);
+        SqliteConnectionPool pool{ path, 2 };
+        ASSERT_EQ(pool.getReaderCount(), 2);
+        ASSERT_FALSE(pool.isEncrypted());
+        ASSERT_TRUE(pool.isUnlocked());
+        pool.setCacheSize(4096);
+        ASSERT_TRUE(pool.registerFunction("twice", [](SqliteFunctionContext& context)
+        {
+            context.result(context.getArgs()[0].as<int>() * 2);
+        }, 1));
+        ASSERT_FALSE(pool.registerAggregateFunction("invalid", { [](SqliteFunctionContext&) { } }));
+        //A function that fails to register on the connections does not block the functions after it
+        ASSERT_TRUE(pool.registerFunction(std::string(300, 'x'), [](SqliteFunctionContext&) { }));
+        ASSERT_TRUE(pool.registerFunction("thrice", [](SqliteFunctionContext& context)
+        {
+            context.result(context.getArg(0).as<int>() * 3);
+        }, 1));
+        {
+            SqliteConnection writer{ pool.getWriter() };
+            ASSERT_TRUE(writer);
+            ASSERT_FALSE(writer.isReadOnly());
+            ASSERT_TRUE(writer->execute("CREATE TABLE numbers (value INTEGER)"));
+            ASSERT_TRUE(writer->bulkInsert("INSERT INTO numbers (value) VALUES (?)", std::vector<std::tuple<int>>{ { 1 }, { 2 }, { 3 } }));
+        }
+        {
+            SqliteConnection reader{ pool.getReader() };
+            ASSERT_TRUE(reader.isReadOnly());
+            ASSERT_FALSE(reader->execute("INSERT INTO numbers (value) VALUES (4)"));
+            SqliteStatement journalMode{ reader->createStatement("PRAGMA journal_mode") };
+            ASSERT_EQ(journalMode.step(), SqliteStepResult::Row);
+            ASSERT_EQ(journalMode.getColumn<std::string>(0), "wal");
+            SqliteStatement cacheSize{ reader->createStatement("PRAGMA cache_size") };
+            ASSERT_EQ(cacheSize.step(), SqliteStepResult::Row);
+            ASSERT_EQ(cacheSize.getColumn<int>(0), -4096);
+        }
+        //Readers see committed data while the writer is leased, each from their own thread
+        SqliteConnection writer{ pool.getWriter() };
+        std::atomic<int> sum{ 0 };
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 4; i++)
+        {
+            threads.emplace_back([&pool, &sum]()
+            {
+                SqliteConnection reader{ pool.getReader() };
+                SqliteStatement statement{ reader->createStatement("SELECT sum(twice(value)) + sum(thrice(value)) FROM numbers") };
+                if(statement.step() == SqliteStepResult::Row)
+                {
+                    sum += statement.getColumn<int>(0);
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        ASSERT_EQ(sum, 120);
+    }
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + "-wal");
+    std::filesystem::remove(path.string() + "-shm");
+}
+
+TEST_F(DatabaseTest, Blobs)
+{
+    std::filesystem::path path{ "blobs.sqlite3" };
+    std::filesystem::remove(path);
+    {
+        SqliteDatabase database{ path };
+        ASSERT_TRUE(database.execute("CREATE TABLE files (name TEXT, data BLOB)"));
+        database.registerFunction("blobsize", [](SqliteFunctionContext& context)
+        {
+            context.result(static_cast<int>(context.getArgs()[0].as<SqliteBlobView>().size()));
+        }, 1);
+        SqliteBlob data(1024 * 1024);
+        for(size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = static_cast<std::byte>(i % 251);
+        }
+        std::string name{ "large.bin" };
+        {
+            SqliteStatement statement{ database.createStatement("INSERT INTO files (name, data) VALUES (?, ?)") };
+            ASSERT_TRUE(statement.bind(1, std::string_view{ name }));
+            ASSERT_TRUE(statement.bind(2, SqliteBlobView{ data }));
+            ASSERT_EQ(statement.step(), SqliteStepResult::Done);
+            statement.reset();
+            ASSERT_TRUE(statement.bind(1, std::string{ "empty.bin" }));
+            ASSERT_TRUE(statement.bind(2, SqliteBlob{}));
+            ASSERT_EQ(statement.step(), SqliteStepResult::Done);
+            statement.reset();
+            ASSERT_TRUE(statement.bind(1, std::string{ "null.bin" }));
+            ASSERT_TRUE(statement.bindNull(2));
+            ASSERT_EQ(statement.step(), SqliteStepResult::Done);
+        }
+        SqliteStatement statement{ database.createStatement("SELECT name, data, blobsize(data) FROM files ORDER BY rowid") };
+        ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+        ASSERT_EQ(statement.getColumn<std::string_view>(0), name);
+        SqliteBlobView view{ statement.getColumn<SqliteBlobView>(1) };
+        ASSERT_EQ(view.size(), data.size());
+        ASSERT_TRUE(std::equal(view.begin(), view.end(), data.begin()));
+        ASSERT_EQ(statement.getColumn<SqliteBlob>(1), data);
+        ASSERT_EQ(statement.getColumn<int>(2), static_cast<int>(data.size()));
+        ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+        ASSERT_EQ(statement.getColumn<std::string_view>(0), "empty.bin");
+        ASSERT_FALSE(statement.isColumnNull(1));
+        ASSERT_TRUE(statement.getColumn<SqliteBlobView>(1).empty());
+        ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+        ASSERT_TRUE(statement.isColumnNull(1));
+        ASSERT_TRUE(statement.getColumn<SqliteBlob>(1).empty());
+        ASSERT_EQ(statement.step(), SqliteStepResult::Done);
+    }
+    std::filesystem::remove(path);
+}
+
+struct Item
+{
+    using SqliteColumns = std::tuple<std::int64_t, std::string, double>;
+
+    std::int64_t id;
+    std::string name;
+    double price;
+};
+
+static_assert(std::ranges::input_range<SqliteRowRange<Item>>);
+
+TEST_F(DatabaseTest, Rows)
+{
+    std::filesystem::path path{ "rows.sqlite3" };
+    std::filesystem::remove(path);
+    {
+        SqliteDatabase database{ path };
+        ASSERT_TRUE(database.execute("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT, price REAL)"));
+        std::vector<std::tuple<std::string, double>> values;
+        for(int i = 0; i < 100; i++)
+        {
+            values.emplace_back("item" + std::to_string(i), i * 1.5);
+        }
+        ASSERT_TRUE(database.bulkInsert("INSERT INTO items (name, price) VALUES (?, ?)", values));
+        {
+            SqliteStatement statement{ database.createStatement("SELECT id, name, price FROM items ORDER BY id") };
+            SqliteRowRange<Item> rows{ statement.rows<Item>() };
+            std::int64_t expectedId{ 1 };
+            for(const Item& item : rows)
+            {
+                ASSERT_EQ(item.id, expectedId);
+                ASSERT_EQ(item.name, "item" + std::to_string(expectedId - 1));
+                ASSERT_EQ(item.price, (expectedId - 1) * 1.5);
+                expectedId++;
+            }
+            ASSERT_EQ(expectedId, 101);
+            ASSERT_FALSE(rows.hasError());
+        }
+        {
+            SqliteStatement statement{ database.createStatement("SELECT name, price FROM items WHERE price >= 75 ORDER BY id") };
+            size_t count{ 0 };
+            for(const std::tuple<std::string_view, double>& row : statement.rows<std::tuple<std::string_view, double>>())
+            {
+                ASSERT_TRUE(std::get<0>(row).starts_with("item"));
+                ASSERT_GE(std::get<1>(row), 75.0);
+                count++;
+            }
+            ASSERT_EQ(count, 50);
+        }
+        {
+            SqliteStatement statement{ database.createStatement("SELECT id, name, price FROM items ORDER BY id") };
+            std::vector<Item> items;
+            ASSERT_TRUE(statement.fetchAll(items, 100));
+            ASSERT_EQ(items.size(), 100);
+            ASSERT_GE(items.capacity(), 100);
+            ASSERT_EQ(items[99].name, "item99");
+        }
+        {
+            SqliteStatement statement{ database.createStatement("SELECT count(*), max(price) FROM items") };
+            ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+            ASSERT_EQ((statement.getRow<std::tuple<int, double>>()), (std::tuple<int, double>{ 100, 148.5 }));
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_F(DatabaseTest, Functions)
+{
+    std::filesystem::path path{ "functions.sqlite3" };
+    std::filesystem::remove(path);
+    {
+        SqliteDatabase database{ path };
+        ASSERT_TRUE(database.execute("CREATE TABLE numbers (value INTEGER)"));
+        std::vector<std::tuple<std::int64_t>> values;
+        for(std::int64_t i = 1; i <= 5; i++)
+        {
+            values.emplace_back(i * 1000000000);
+        }
+        ASSERT_TRUE(database.bulkInsert("INSERT INTO numbers (value) VALUES (?)", values));
+        ASSERT_TRUE(database.registerFunction("half", [](SqliteFunctionContext& context)
+        {
+            if(context.getArg(0).isNull())
+            {
+                context.result();
+                return;
+            }
+            context.result(context.getArg(0).as<std::int64_t>() / 2);
+        }, 1, SqliteFunctionFlags::Deterministic | SqliteFunctionFlags::Innocuous));
+        ASSERT_TRUE(database.registerFunction("fail", [](SqliteFunctionContext&)
+        {
+            throw std::runtime_error("Failed.");
+        }, 0));
+        ASSERT_TRUE(database.registerAggregateFunction("total", { [](SqliteFunctionContext& context)
+        {
+            context.getState<std::int64_t>() += context.getArg(0).as<std::int64_t>();
+        }, [](SqliteFunctionContext& context)
+        {
+            context.result(context.getState<std::int64_t>());
+        } }, 1, SqliteFunctionFlags::Deterministic));
+        ASSERT_TRUE(database.registerAggregateFunction("concat", { [](SqliteFunctionContext& context)
+        {
+            context.getState<std::vector<std::string>>().push_back(std::to_string(context.getArg(0).as<std::int64_t>() / 1000000000));
+        }, [](SqliteFunctionContext& context)
+        {
+            std::string result;
+            for(const std::string& value : context.getState<std::vector<std::string>>())
+            {
+                result += value;
+            }
+            context.result(result);
+        }, [](SqliteFunctionContext& context)
+        {
+            std::string result;
+            for(const std::string& value : context.getState<std::vector<std::string>>())
+            {
+                result += value;
+            }
+            context.result(result);
+        }, [](SqliteFunctionContext& context)
+        {
+            std::vector<std::string>& state{ context.getState<std::vector<std::string>>() };
+            state.erase(state.begin());
+        } }, 1));
+        ASSERT_FALSE(database.registerAggregateFunction("invalid", { [](SqliteFunctionContext&) { } }));
+        {
+            SqliteStatement statement{ database.createStatement("SELECT half(value), half(NULL) FROM numbers ORDER BY value DESC LIMIT 1") };
+            ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+            ASSERT_EQ(statement.getColumn<std::int64_t>(0), 2500000000);
+            ASSERT_TRUE(statement.isColumnNull(1));
+        }
+        {
+            SqliteStatement statement{ database.createStatement("SELECT total(value) FROM numbers") };
+            ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+            ASSERT_EQ(statement.getColumn<std::int64_t>(0), 15000000000);
+        }
+        {
+            SqliteStatement statement{ database.createStatement("SELECT total(value) FROM numbers WHERE value < 0") };
+            ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+            ASSERT_EQ(statement.getColumn<std::int64_t>(0), 0);
+        }
+        {
+            SqliteStatement statement{ database.createStatement("SELECT concat(value) OVER (ORDER BY value ROWS BETWEEN 1 PRECEDING AND CURRENT ROW) FROM numbers") };
+            std::vector<std::tuple<std::string>> windows;
+            ASSERT_TRUE(statement.fetchAll(windows));
+            ASSERT_EQ(windows, (std::vector<std::tuple<std::string>>{ { "1" }, { "12" }, { "23" }, { "34" }, { "45" } }));
+        }
+        {
+            SqliteStatement statement{ database.createStatement("SELECT fail()") };
+            ASSERT_EQ(statement.step(), SqliteStepResult::Error);
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_F(DatabaseTest, Async)
+{
+    std::filesystem::path path{ "async.sqlite3" };
+    std::filesystem::remove(path);
+    {
+        AsyncSqliteDatabase database{ path };
+        ASSERT_EQ(database.getPath(), path);
+        ASSERT_TRUE(database.execute("CREATE TABLE numbers (value INTEGER UNIQUE)").get());
+        std::vector<std::future<bool>> inserts;
+        for(int i = 0; i < 100; i++)
+        {
+            inserts.push_back(database.write([i](SqliteDatabase& connection)
+            {
+                SqliteStatement statement{ connection.createStatement("INSERT INTO numbers (value) VALUES (?)") };
+                statement.bind(1, i);
+                return statement.step() == SqliteStepResult::Done;
+            }));
+        }
+        //A failing write is rolled back without affecting the rest of its batch
+        std::future<void> failed{ database.write([](SqliteDatabase& connection)
+        {
+            connection.execute("INSERT INTO numbers (value) VALUES (1000)");
+            throw std::runtime_error("Failed.");
+        }) };
+        std::unique_ptr<int> value{ std::make_unique<int>(1001) };
+        std::future<void> moved{ database.write([value = std::move(value)](SqliteDatabase& connection)
+        {
+            connection.execute("INSERT INTO numbers (value) VALUES (" + std::to_string(*value) + ")");
+        }) };
+        std::future<int> count{ database.read([](SqliteDatabase& connection)
+        {
+            SqliteStatement statement{ connection.createStatement("SELECT count(*) FROM numbers") };
+            statement.step();
+            return statement.getColumn<int>(0);
+        }) };
+        for(std::future<bool>& insert : inserts)
+        {
+            ASSERT_TRUE(insert.get());
+        }
+        ASSERT_THROW(failed.get(), std::runtime_error);
+        ASSERT_NO_THROW(moved.get());
+        ASSERT_EQ(count.get(), 101);
+        //A cancelled token interrupts the task's running command
+        std::shared_ptr<CancellationToken> token{ std::make_shared<CancellationToken>() };
+        std::future<bool> slow{ database.read([](SqliteDatabase& connection)
+        {
+            return connection.execute("WITH RECURSIVE n(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM n) SELECT count(*) FROM n");
+        }, token) };
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        token->cancel();
+        ASSERT_THROW(slow.get(), std::runtime_error);
+        ASSERT_THROW(database.read([](SqliteDatabase&) { return 0; }, token).get(), std::runtime_error);
+        //Cancelling a queued write only rolls back that write, not the writes queued around it
+        std::promise<void> gate;
+        std::future<void> blocked{ database.read([opened = gate.get_future().share()](SqliteDatabase&)
+        {
+            opened.wait();
+        }) };
+        std::promise<void> started;
+        std::shared_ptr<CancellationToken> writeToken{ std::make_shared<CancellationToken>() };
+        std::future<bool> before{ database.execute("INSERT INTO numbers (value) VALUES (2000)") };
+        std::future<bool> cancelled{ database.write([&started](SqliteDatabase& connection)
+        {
+            connection.execute("INSERT INTO numbers (value) VALUES (2001)");
+            started.set_value();
+            //An interrupted insert rolls back the whole transaction
+            return connection.execute("INSERT INTO numbers (value) WITH RECURSIVE n(x) AS (SELECT 3000 UNION ALL SELECT x + 1 FROM n) SELECT x FROM n");
+        }, writeToken) };
+        std::future<bool> after{ database.execute("INSERT INTO numbers (value) VALUES (2002)") };
+        gate.set_value();
+        started.get_future().wait();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        writeToken->cancel();
+        ASSERT_NO_THROW(blocked.get());
+        ASSERT_THROW(cancelled.get(), std::runtime_error);
+        ASSERT_TRUE(before.get());
+        ASSERT_TRUE(after.get());
+        std::future<int> written{ database.read([](SqliteDatabase& connection)
+        {
+            SqliteStatement statement{ connection.createStatement("SELECT count(*) FROM numbers WHERE value >= 2000") };
+            statement.step();
+            return statement.getColumn<int>(0);
+        }) };
+        ASSERT_EQ(written.get(), 2);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_F(DatabaseTest, Backup)
+{
+    std::filesystem::path path{ "backupsource.sqlite3" };
+    std::filesystem::path destination{ "backup.sqlite3" };
+    std::filesystem::remove(path);
+    std::filesystem::remove(destination);
+    {
+        SqliteDatabase database{ path };
+        ASSERT_TRUE(database.execute("CREATE TABLE files (data BLOB)"));
+        std::vector<std::tuple<SqliteBlob>> files;
+        for(int i = 0; i < 16; i++)
+        {
+            files.emplace_back(SqliteBlob(256 * 1024, static_cast<std::byte>(i)));
+        }
+        ASSERT_TRUE(database.bulkInsert("INSERT INTO files (data) VALUES (?)", files));
+        //A cancelled backup leaves no destination behind
+        std::shared_ptr<CancellationToken> token{ std::make_shared<CancellationToken>() };
+        //The password cannot be changed while a backup is running
+        bool passwordChanged{ true };
+        HandlerId handler{ database.backupProgressChanged().subscribe([&database, &token, &passwordChanged](const SqliteBackupProgressChangedEventArgs&)
+        {
+            passwordChanged = database.setPassword("password");
+            token->cancel();
+        }) };
+        ASSERT_FALSE(database.backup(destination, "", token));
+        ASSERT_FALSE(passwordChanged);
+        ASSERT_FALSE(database.isEncrypted());
+        ASSERT_FALSE(std::filesystem::exists(destination));
+        ASSERT_FALSE(std::filesystem::exists(destination.string() + ".backup"));
+        database.backupProgressChanged().unsubscribe(handler);
+        std::vector<double> progress;
+        database.backupProgressChanged().subscribe([&progress](const SqliteBackupProgressChangedEventArgs& args)
+        {
+            progress.push_back(args.getProgress());
+        });
+        ASSERT_TRUE(database.backup(destination));
+        ASSERT_GT(progress.size(), 1);
+        ASSERT_EQ(progress.back(), 1.0);
+        ASSERT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+        ASSERT_TRUE(database.execute("DELETE FROM files"));
+    }
+    {
+        SqliteDatabase copy{ destination };
+        SqliteStatement statement{ copy.createStatement("SELECT count(*), sum(length(data)) FROM files") };
+        ASSERT_EQ(statement.step(), SqliteStepResult::Row);
+        ASSERT_EQ((statement.getRow<std::tuple<int, std::int64_t>>()), (std::tuple<int, std::int64_t>{ 16, 16 * 256 * 1024 }));
+    }
+    std::filesystem::remove(path);
+    std::filesystem::remove(destination);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <fstream>
+#include "filesystem/directoryscanner.h"
+
+using namespace Nickvision::Filesystem;
+
+class DirectoryScannerTest : public testing::Test
+{
+public:
+    static std::filesystem::path m_root;
+
+    static void SetUpTestSuite()
+    {
+        std::filesystem::create_directories(m_root / "a" / "b");
+        std::filesystem::create_directories(m_root / "c");
+        std::ofstream{ m_root / "1.txt" };
+        std::ofstream{ m_root / "a" / "2.txt" };
+        std::ofstream{ m_root / "a" / "b" / "3.txt" };
+        std::ofstream{ m_root / "c" / "4.txt" };
+    }
+
+    static void TearDownTestSuite()
+    {
+        std::filesystem::remove_all(m_root);
+    }
+
+    static bool contains(const std::vector<std::filesystem::path>& paths, const std::filesystem::path& path)
+    {
+        return std::find(paths.begin(), paths.end(), path) != paths.end();
+    }
+};
+
+std::filesystem::path DirectoryScannerTest::m_root{ "scannertest" };
+
+TEST_F(DirectoryScannerTest, ScanAll)
+{
+    std::vector<std::filesystem::path> paths;
+    ASSERT_NO_THROW(paths = DirectoryScanner::scan(m_root));
+    ASSERT_EQ(paths.size(), 7);
+    ASSERT_TRUE(contains(paths, m_root / "a" / "b" / "3.txt"));
+    ASSERT_TRUE(contains(paths, m_root / "c"));
+}
+
+TEST_F(DirectoryScannerTest, ScanDirectories)
+{
+    std::vector<std::filesystem::path> paths{ DirectoryScanner::scan(m_root, ScanFlags::Directories | ScanFlags::Recursive, 2) };
+    ASSERT_EQ(paths.size(), 3);
+    ASSERT_TRUE(contains(paths, m_root / "a"));
+    ASSERT_TRUE(contains(paths, m_root / "a" / "b"));
+    ASSERT_TRUE(contains(paths, m_root / "c"));
+}
+
+TEST_F(DirectoryScannerTest, ScanFilesNonRecursive)
+{
+    std::vector<std::filesystem::path> paths{ DirectoryScanner::scan(m_root, ScanFlags::Files) };
+    ASSERT_EQ(paths.size(), 1);
+    ASSERT_EQ(paths[0], m_root / "1.txt");
+}
+
+TEST_F(DirectoryScannerTest, ScanMissing)
+{
+    ASSERT_TRUE(DirectoryScanner::scan(m_root / "missing").empty());
+}
+
+#ifndef _WIN32
+TEST_F(DirectoryScannerTest, ScanFollowSymlinks)
+{
+    std::filesystem::path link{ m_root / "c" / "link" };
+    ASSERT_NO_THROW(std::filesystem::create_directory_symlink(std::filesystem::absolute(m_root / "a"), link));
+    std::vector<std::filesystem::path> paths{ DirectoryScanner::scan(m_root, ScanFlags::Directories | ScanFlags::Recursive) };
+    ASSERT_EQ(paths.size(), 3);
+    ASSERT_FALSE(contains(paths, link));
+    paths = DirectoryScanner::scan(m_root, ScanFlags::Directories | ScanFlags::Recursive | ScanFlags::FollowSymlinks);
+    ASSERT_EQ(paths.size(), 4);
+    ASSERT_TRUE(contains(paths, link));
+    ASSERT_FALSE(contains(paths, link / "b"));
+    ASSERT_TRUE(std::filesystem::remove(link));
+}
+#endif
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include "helpers/hashedstring.h"
+#include "helpers/hashhelpers.h"
+#include "helpers/pairhash.h"
+
+using namespace Nickvision::Helpers;
+
+static std::string randomString(std::mt19937& random, size_t size)
+{
+    std::string s(size, '\0');
+    for(char& c : s)
+    {
+        c = static_cast<char>(random());
+    }
+    return s;
+}
+
+TEST(HashTests, Stable)
+{
+    ASSERT_EQ(HashHelpers::hash64(""), HashHelpers::hash64(std::span<const std::byte>{}));
+    ASSERT_EQ(HashHelpers::hash64("libnick"), HashHelpers::hash64("libnick"));
+    ASSERT_NE(HashHelpers::hash64("libnick"), HashHelpers::hash64("libnicK"));
+    ASSERT_NE(HashHelpers::hash64("libnick"), HashHelpers::hash64("libnick", 1));
+    HashHelpers::Hash128 hash{ HashHelpers::hash128("libnick") };
+    ASSERT_NE(hash.low, hash.high);
+    ASSERT_EQ(hash.low, HashHelpers::hash64("libnick"));
+}
+
+TEST(HashTests, Streaming)
+{
+    std::mt19937 random{ 42 };
+    for(size_t size = 0; size < 300; size++)
+    {
+        std::string s{ randomString(random, size) };
+        HashHelpers::Hasher hasher;
+        size_t pos{ 0 };
+        while(pos < s.size())
+        {
+            size_t piece{ std::min<size_t>(random() % 60, s.size() - pos) };
+            hasher.update(std::string_view(s).substr(pos, piece));
+            pos += piece;
+        }
+        ASSERT_EQ(hasher.digest64(), HashHelpers::hash64(s));
+        ASSERT_EQ(hasher.digest128(), HashHelpers::hash128(s));
+    }
+}
+
+TEST(HashTests, Distribution)
+{
+    std::set<std::uint64_t> hashes;
+    for(int i = 0; i < 100000; i++)
+    {
+        hashes.insert(HashHelpers::hash64(std::to_string(i)));
+    }
+    ASSERT_EQ(hashes.size(), 100000);
+}
+
+TEST(HashTests, File)
+{
+    std::string contents(100000, 'a');
+    std::ofstream{ "hash.txt", std::ios::binary } << contents;
+    ASSERT_EQ(HashHelpers::hashFile("hash.txt"), HashHelpers::hash128(contents));
+    ASSERT_EQ(HashHelpers::hashFile("hash_missing.txt"), (HashHelpers::Hash128{ 0, 0 }));
+    std::filesystem::remove("hash.txt");
+}
+
+TEST(HashTests, HashedString)
+{
+    std::unordered_map<HashedString, int> map;
+    map["one"] = 1;
+    map[std::string("two")] = 2;
+    ASSERT_EQ(map.at("one"), 1);
+    ASSERT_EQ(map.at(HashedString{ std::string_view("two") }), 2);
+    ASSERT_EQ(HashedString("one").getHash(), HashHelpers::hash64("one"));
+    ASSERT_FALSE(HashedString("one") == HashedString("One"));
+}
+
+TEST(HashTests, PairHash)
+{
+    PairHash hash;
+    ASSERT_NE(hash(std::make_pair(std::string("a"), 0)), hash(std::make_pair(std::string("a"), 1)));
+    ASSERT_NE(hash(std::make_pair(std::string("a"), 0)), hash(std::make_pair(std::string("b"), 0)));
+    ASSERT_NE(hash(std::make_pair(1, 2)), hash(std::make_pair(2, 1)));
+    ASSERT_EQ(hash(std::make_pair(HashedString("a"), 0)), hash(std::make_pair(std::string("a"), 0)));
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "app/windowgeometry.h"
+#include "helpers/jsonarrayreader.h"
+#include "helpers/jsonarraywriter.h"
+
+using namespace Nickvision::App;
+using namespace Nickvision::Helpers;
+
+TEST(JsonArrayTests, WriteAndReadFile)
+{
+    std::filesystem::path path{ "array.json" };
+    {
+        JsonArrayWriter writer{ path };
+        for(long i = 0; i < 10000; i++)
+        {
+            ASSERT_TRUE(writer.write(WindowGeometry{ i, i * 2, i % 2 == 0, i, -i }));
+        }
+        ASSERT_EQ(writer.getCount(), 10000);
+        ASSERT_TRUE(writer.finish());
+        ASSERT_TRUE(writer.isFinished());
+        ASSERT_FALSE(writer.write(WindowGeometry{}));
+    }
+    JsonArrayReader reader{ path };
+    long i{ 0 };
+    while(std::optional<boost::json::value> element{ reader.next() })
+    {
+        WindowGeometry geometry{ element->as_object() };
+        ASSERT_EQ(geometry.getWidth(), i);
+        ASSERT_EQ(geometry.getHeight(), i * 2);
+        ASSERT_EQ(geometry.isMaximized(), i % 2 == 0);
+        ASSERT_EQ(geometry.getY(), -i);
+        i++;
+    }
+    ASSERT_FALSE(reader.hasError());
+    ASSERT_EQ(reader.getCount(), 10000);
+    std::filesystem::remove(path);
+}
+
+TEST(JsonArrayTests, WriteAndReadString)
+{
+    std::string json;
+    JsonArrayWriter writer{ json };
+    ASSERT_TRUE(writer.write(boost::json::value{ "a],\"b" }));
+    ASSERT_TRUE(writer.write(boost::json::parse(R"({"x":[1,{"y":"}"}]})")));
+    ASSERT_TRUE(writer.write(boost::json::value{ nullptr }));
+    ASSERT_TRUE(writer.finish());
+    ASSERT_EQ(boost::json::parse(json).as_array().size(), 3);
+    JsonArrayReader reader{ std::as_bytes(std::span{ json }) };
+    ASSERT_EQ(reader.next(), boost::json::value{ "a],\"b" });
+    ASSERT_EQ(reader.next(), boost::json::parse(R"({"x":[1,{"y":"}"}]})"));
+    ASSERT_EQ(reader.next(), boost::json::value{ nullptr });
+    ASSERT_FALSE(reader.next().has_value());
+    ASSERT_FALSE(reader.hasError());
+}
+
+TEST(JsonArrayTests, Empty)
+{
+    std::string json;
+    JsonArrayWriter writer{ json };
+    ASSERT_TRUE(writer.finish());
+    ASSERT_EQ(json, "[]\n");
+    JsonArrayReader reader{ std::as_bytes(std::span{ json }) };
+    ASSERT_FALSE(reader.next().has_value());
+    ASSERT_FALSE(reader.hasError());
+}
+
+TEST(JsonArrayTests, Invalid)
+{
+    for(std::string_view json : { "", "{}", "[1,]", "[1", "[1}", "[1,{]" })
+    {
+        JsonArrayReader reader{ std::as_bytes(std::span{ json }) };
+        while(reader.next())
+        {
+
+        }
+        ASSERT_TRUE(reader.hasError());
+    }
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "app/windowgeometry.h"
+#include "helpers/jsonfields.h"
+
+using namespace Nickvision::App;
+using namespace Nickvision::Helpers;
+
+struct Recent
+{
+    std::string path{ "" };
+    int count{ 0 };
+    double score{ 0.5 };
+    bool pinned{ false };
+    boost::json::array tags;
+
+    static constexpr auto getJsonFields() noexcept
+    {
+        return std::make_tuple(JsonField{ "Path", &Recent::path },
+            JsonField{ "Count", &Recent::count },
+            JsonField{ "Score", &Recent::score },
+            JsonField{ "Pinned", &Recent::pinned },
+            JsonField{ "Tags", &Recent::tags });
+    }
+};
+
+TEST(JsonFieldsTests, ToString)
+{
+    Recent recent{ "C:\\Users\\\"Me\"\n", -3, 2.0, true, { "a", 1 } };
+    std::string json{ JsonFields::toString(recent, Recent::getJsonFields()) };
+    ASSERT_EQ(boost::json::parse(json), JsonFields::toObject(recent, Recent::getJsonFields()));
+    ASSERT_TRUE(boost::json::parse(json).at("Score").is_double());
+    std::string escaped;
+    JsonFields::appendString(escaped, std::string_view{ "a\"b\\c\n\x01", 7 });
+    ASSERT_EQ(escaped, R"("a\"b\\c\n\u0001")");
+}
+
+TEST(JsonFieldsTests, FromObject)
+{
+    Recent recent;
+    JsonFields::fromObject(boost::json::parse(R"({"Path":"file.txt","Count":"wrong","Score":3,"Extra":1,"Tags":["x"]})").as_object(), recent, Recent::getJsonFields());
+    ASSERT_EQ(recent.path, "file.txt");
+    ASSERT_EQ(recent.count, 0);
+    ASSERT_EQ(recent.score, 3.0);
+    ASSERT_FALSE(recent.pinned);
+    ASSERT_EQ(recent.tags.size(), 1);
+}
+
+TEST(JsonFieldsTests, WindowGeometry)
+{
+    WindowGeometry geometry{ 1280, 720, true, 40, 50 };
+    WindowGeometry copy{ boost::json::parse(geometry.toJsonString()).as_object() };
+    ASSERT_EQ(copy.getWidth(), 1280);
+    ASSERT_EQ(copy.getHeight(), 720);
+    ASSERT_TRUE(copy.isMaximized());
+    ASSERT_EQ(copy.getX(), 40);
+    ASSERT_EQ(copy.getY(), 50);
+    ASSERT_EQ(geometry.toJson(), boost::json::parse(geometry.toJsonString()));
+    WindowGeometry defaults{ boost::json::object{ { "Width", 1024 } } };
+    ASSERT_EQ(defaults.getWidth(), 1024);
+    ASSERT_EQ(defaults.getHeight(), 600);
+    ASSERT_EQ(defaults.getX(), 10);
+}
@@ -1,11 +1,19 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include "app/windowgeometry.h"
 #include "filesystem/userdirectories.h"
 #include "helpers/jsonfilebase.h"
+#include "helpers/jsonproperty.h"
 
 using namespace Nickvision::App;
+using namespace Nickvision::Events;
 using namespace Nickvision::Filesystem;
 using namespace Nickvision::Helpers;
 
@@ -19,8 +27,8 @@ enum class Theme
 class AppConfig : public JsonFileBase
 {
 public:
-    AppConfig(const std::filesystem::path& path)
-        : JsonFileBase{ path }
+    AppConfig(const std::filesystem::path& path, bool loadLazily = false, bool useSnapshot = false)
+        : JsonFileBase{ path, loadLazily, useSnapshot }
     {
 
     }
@@ -82,6 +90,39 @@ public:
     }
 };
 
+class PropertyConfig : public AppConfig
+{
+public:
+    PropertyConfig(const std::filesystem::path& path)
+        : AppConfig{ path, true },
+        m_theme{ property("Theme", static_cast<int>(Theme::System)) },
+        m_language{ property<std::string>("Language", "en") },
+        m_recents{ property<boost::json::array>("Recents", {}) }
+    {
+
+    }
+
+    const JsonProperty<int>& theme() const
+    {
+        return m_theme;
+    }
+
+    JsonProperty<std::string>& language()
+    {
+        return m_language;
+    }
+
+    JsonProperty<boost::json::array>& recents()
+    {
+        return m_recents;
+    }
+
+private:
+    JsonProperty<int> m_theme;
+    JsonProperty<std::string> m_language;
+    JsonProperty<boost::json::array> m_recents;
+};
+
 class JsonFileTest : public testing::Test
 {
 public:
@@ -234,4 +275,175 @@ TEST_F(JsonFileTest, ReloadAndCheckPortableConfig)
     ASSERT_EQ(geometry.isMaximized(), true);
     ASSERT_EQ(m_portableConfig->getAutomaticallyCheckForUpdates(), false);
     ASSERT_EQ(m_portableConfig->getLanguage(), "fr");
-}
\ No newline at end of file
+}
+
+TEST_F(JsonFileTest, ReloadLazilyAndCheckPortableConfig)
+{
+    AppConfig config{ m_portablePath, true };
+    ASSERT_EQ(config.getTheme(), Theme::Light);
+    ASSERT_EQ(config.getAutomaticallyCheckForUpdates(), false);
+    ASSERT_EQ(config.getLanguage(), "fr");
+}
+
+TEST_F(JsonFileTest, AutoSave)
+{
+    std::filesystem::path path{ "autosave.json" };
+    std::filesystem::remove(path);
+    std::mutex mutex;
+    std::condition_variable condition;
+    int saves{ 0 };
+    {
+        AppConfig config{ path };
+        config.saved() += [&](const EventArgs&)
+        {
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                saves++;
+            }
+            condition.notify_all();
+        };
+        ASSERT_FALSE(config.isAutoSaveEnabled());
+        config.enableAutoSave(std::chrono::milliseconds{ 1000 });
+        ASSERT_TRUE(config.isAutoSaveEnabled());
+        for(int i = 0; i < 100; i++)
+        {
+            config.setLanguage(std::to_string(i));
+        }
+        {
+            std::unique_lock<std::mutex> lock{ mutex };
+            ASSERT_TRUE(condition.wait_for(lock, std::chrono::seconds{ 30 }, [&saves]() { return saves > 0; }));
+            ASSERT_EQ(saves, 1);
+        }
+        ASSERT_EQ(AppConfig{ path }.getLanguage(), "99");
+        config.setLanguage("last");
+    }
+    //The destructor saves pending changes without invoking the saved event
+    ASSERT_EQ(saves, 1);
+    ASSERT_EQ(AppConfig{ path }.getLanguage(), "last");
+    std::filesystem::remove(path);
+}
+
+TEST_F(JsonFileTest, Properties)
+{
+    std::filesystem::remove("properties.json");
+    PropertyConfig config{ "properties.json" };
+    const JsonProperty<int>& theme{ config.theme() };
+    JsonProperty<std::string>& language{ config.language() };
+    JsonProperty<boost::json::array>& recents{ config.recents() };
+    ASSERT_EQ(theme.getKey(), "Theme");
+    ASSERT_EQ(theme.get(), static_cast<int>(Theme::System));
+    ASSERT_EQ(*language.get(), "en");
+    ASSERT_TRUE(recents.get()->empty());
+    std::shared_ptr<const std::string> cached{ language.get() };
+    ASSERT_EQ(language.get(), cached);
+    ASSERT_NO_THROW(config.setTheme(Theme::Dark));
+    ASSERT_EQ(theme.get(), static_cast<int>(Theme::Dark));
+    ASSERT_NO_THROW(language.set("fr"));
+    ASSERT_EQ(*language.get(), "fr");
+    ASSERT_EQ(config.getLanguage(), "fr");
+    ASSERT_EQ(*cached, "en");
+    ASSERT_NO_THROW(recents.set(boost::json::array{ "a", "b" }));
+    ASSERT_EQ(recents.get()->size(), 2);
+    std::filesystem::remove("properties.json");
+}
+
+TEST_F(JsonFileTest, Snapshot)
+{
+    std::filesystem::path path{ "snapshot.json" };
+    std::filesystem::path snapshotPath{ "snapshot.json.snapshot" };
+    std::filesystem::remove(path);
+    std::filesystem::remove(snapshotPath);
+    {
+        AppConfig config{ path, false, true };
+        ASSERT_FALSE(config.isDurableSaveEnabled());
+        config.enableDurableSave();
+        ASSERT_TRUE(config.isDurableSaveEnabled());
+        config.setTheme(Theme::Dark);
+        config.setWindowGeometry(WindowGeometry{ 1280, 720, false });
+        config.setLanguage("de");
+        ASSERT_TRUE(config.save());
+    }
+    ASSERT_TRUE(std::filesystem::exists(snapshotPath));
+    {
+        AppConfig config{ path, false, true };
+        WindowGeometry geometry{ config.getWindowGeometry() };
+        ASSERT_EQ(config.getTheme(), Theme::Dark);
+        ASSERT_EQ(geometry.getWidth(), 1280);
+        ASSERT_EQ(geometry.getHeight(), 720);
+        ASSERT_EQ(geometry.isMaximized(), false);
+        ASSERT_EQ(config.getLanguage(), "de");
+    }
+    //A json file changed by someone else makes the snapshot out of date
+    {
+        std::ofstream file{ path, std::ios::trunc };
+        file << "{\"Language\":\"es\"}\n";
+    }
+    ASSERT_EQ(AppConfig(path, false, true).getLanguage(), "es");
+    //A corrupt snapshot is ignored
+    {
+        AppConfig config{ path, false, true };
+        config.setLanguage("it");
+        ASSERT_TRUE(config.save());
+    }
+    std::filesystem::resize_file(snapshotPath, std::filesystem::file_size(snapshotPath) - 1);
+    ASSERT_EQ(AppConfig(path, false, true).getLanguage(), "it");
+    std::filesystem::remove(path);
+    std::filesystem::remove(snapshotPath);
+}
+
+TEST_F(JsonFileTest, Journal)
+{
+    std::filesystem::path path{ "journal.json" };
+    std::filesystem::path journalPath{ "journal.json.journal" };
+    std::filesystem::remove(path);
+    std::filesystem::remove(journalPath);
+    {
+        AppConfig config{ path };
+        config.setLanguage("en");
+        ASSERT_TRUE(config.save());
+        ASSERT_FALSE(config.isJournalEnabled());
+        config.enableJournal(512);
+        ASSERT_TRUE(config.isJournalEnabled());
+        std::uintmax_t size{ std::filesystem::file_size(path) };
+        config.setTheme(Theme::Dark);
+        config.setLanguage("a/b~c");
+        ASSERT_TRUE(config.save());
+        ASSERT_TRUE(std::filesystem::exists(journalPath));
+        ASSERT_EQ(std::filesystem::file_size(path), size);
+    }
+    {
+        AppConfig config{ path };
+        ASSERT_EQ(config.getTheme(), Theme::Dark);
+        ASSERT_EQ(config.getLanguage(), "a/b~c");
+        config.enableJournal(512);
+        for(int i = 0; i < 100 && std::filesystem::exists(journalPath); i++)
+        {
+            config.setLanguage(std::to_string(i));
+            ASSERT_TRUE(config.save());
+        }
+        //The journal was compacted into the file
+        ASSERT_FALSE(std::filesystem::exists(journalPath));
+        config.setTheme(Theme::Light);
+        ASSERT_TRUE(config.save());
+        ASSERT_TRUE(std::filesystem::exists(journalPath));
+        config.disableJournal();
+        ASSERT_TRUE(config.save());
+        ASSERT_FALSE(std::filesystem::exists(journalPath));
+    }
+    //A partially written entry is ignored
+    {
+        std::ofstream file{ journalPath };
+        file << "[{\"op\":\"add\",\"path\":\"/Language\",\"value\":\"fr\"}]\n[{\"op\":\"add\",\"pa";
+    }
+    {
+        AppConfig config{ path };
+        ASSERT_EQ(config.getTheme(), Theme::Light);
+        ASSERT_EQ(config.getLanguage(), "fr");
+        config.enableJournal();
+        config.setLanguage("de");
+        ASSERT_TRUE(config.save());
+    }
+    ASSERT_EQ(AppConfig{ path }.getLanguage(), "de");
+    std::filesystem::remove(path);
+    std::filesystem::remove(journalPath);
+}
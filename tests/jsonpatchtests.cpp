@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "helpers/jsonpatch.h"
+
+using namespace Nickvision::Helpers;
+
+static bool apply(boost::json::value& document, std::string_view patch)
+{
+    return JsonPatch::apply(document, boost::json::parse(patch).as_array());
+}
+
+TEST(JsonPatchTests, Escape)
+{
+    ASSERT_EQ(JsonPatch::escape("Width"), "Width");
+    ASSERT_EQ(JsonPatch::escape("a/b~c"), "a~1b~0c");
+    ASSERT_EQ(JsonPatch::escape(""), "");
+}
+
+TEST(JsonPatchTests, Add)
+{
+    boost::json::value document{ boost::json::parse(R"({"foo":["bar","baz"]})") };
+    ASSERT_TRUE(apply(document, R"([{"op":"add","path":"/baz","value":"qux"},{"op":"add","path":"/foo/1","value":"qux"},{"op":"add","path":"/foo/-","value":"end"}])"));
+    ASSERT_EQ(document, boost::json::parse(R"({"foo":["bar","qux","baz","end"],"baz":"qux"})"));
+    ASSERT_TRUE(apply(document, R"([{"op":"add","path":"/a~1b","value":1}])"));
+    ASSERT_EQ(document.at("a/b"), 1);
+    ASSERT_FALSE(apply(document, R"([{"op":"add","path":"/foo/9","value":1}])"));
+    ASSERT_FALSE(apply(document, R"([{"op":"add","path":"/missing/key","value":1}])"));
+}
+
+TEST(JsonPatchTests, RemoveAndReplace)
+{
+    boost::json::value document{ boost::json::parse(R"({"baz":"qux","foo":["bar","qux","baz"]})") };
+    ASSERT_TRUE(apply(document, R"([{"op":"remove","path":"/foo/1"},{"op":"replace","path":"/baz","value":"boo"}])"));
+    ASSERT_EQ(document, boost::json::parse(R"({"baz":"boo","foo":["bar","baz"]})"));
+    ASSERT_FALSE(apply(document, R"([{"op":"remove","path":"/missing"}])"));
+    ASSERT_FALSE(apply(document, R"([{"op":"replace","path":"/missing","value":1}])"));
+}
+
+TEST(JsonPatchTests, MoveCopyAndTest)
+{
+    boost::json::value document{ boost::json::parse(R"({"foo":{"bar":"baz","waldo":"fred"},"qux":{"corge":"grault"}})") };
+    ASSERT_TRUE(apply(document, R"([{"op":"move","from":"/foo/waldo","path":"/qux/thud"},{"op":"copy","from":"/qux","path":"/copy"}])"));
+    ASSERT_EQ(document, boost::json::parse(R"({"foo":{"bar":"baz"},"qux":{"corge":"grault","thud":"fred"},"copy":{"corge":"grault","thud":"fred"}})"));
+    ASSERT_FALSE(apply(document, R"([{"op":"move","from":"/foo","path":"/foo/bar"}])"));
+    ASSERT_TRUE(apply(document, R"([{"op":"test","path":"/foo/bar","value":"baz"}])"));
+    ASSERT_FALSE(apply(document, R"([{"op":"test","path":"/foo/bar","value":"qux"}])"));
+}
+
+TEST(JsonPatchTests, Invalid)
+{
+    boost::json::value document{ boost::json::parse(R"({"foo":1})") };
+    ASSERT_FALSE(apply(document, R"([{"op":"unknown","path":"/foo"}])"));
+    ASSERT_FALSE(apply(document, R"([{"op":"add","path":"foo","value":1}])"));
+    ASSERT_FALSE(apply(document, R"([{"op":"add","path":"/~2","value":1}])"));
+    ASSERT_FALSE(apply(document, R"([{"path":"/foo"}])"));
+    ASSERT_FALSE(apply(document, R"([1])"));
+    ASSERT_EQ(document, boost::json::parse(R"({"foo":1})"));
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <vector>
+#include "filesystem/chunkedfilereader.h"
+#include "filesystem/mappedfile.h"
+#include "helpers/codehelpers.h"
+
+using namespace Nickvision::Filesystem;
+using namespace Nickvision::Helpers;
+
+class MappedFileTest : public testing::Test
+{
+public:
+    static std::filesystem::path m_path;
+    static std::filesystem::path m_emptyPath;
+    static std::string m_contents;
+
+    static void SetUpTestSuite()
+    {
+        for(int i = 0; i < 10000; i++)
+        {
+            m_contents += std::to_string(i);
+        }
+        std::ofstream{ m_path, std::ios::binary } << m_contents;
+        std::ofstream{ m_emptyPath, std::ios::binary };
+    }
+
+    static void TearDownTestSuite()
+    {
+        std::filesystem::remove(m_path);
+        std::filesystem::remove(m_emptyPath);
+    }
+};
+
+std::filesystem::path MappedFileTest::m_path{ "mapped.txt" };
+std::filesystem::path MappedFileTest::m_emptyPath{ "mapped_empty.txt" };
+std::string MappedFileTest::m_contents{};
+
+TEST_F(MappedFileTest, Map)
+{
+    MappedFile file{ m_path };
+    ASSERT_EQ(file.size(), m_contents.size());
+    std::span<const std::byte> bytes{ file.getBytes() };
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()), m_contents);
+    MappedFile moved{ std::move(file) };
+    ASSERT_TRUE(file.getBytes().empty());
+    ASSERT_EQ(moved.getBytes().size(), m_contents.size());
+}
+
+TEST_F(MappedFileTest, MapEmpty)
+{
+    MappedFile file{ m_emptyPath };
+    ASSERT_EQ(file.size(), 0);
+    ASSERT_TRUE(file.getBytes().empty());
+}
+
+TEST_F(MappedFileTest, MapMissing)
+{
+    ASSERT_THROW(MappedFile("mapped_missing.txt"), std::runtime_error);
+}
+
+TEST_F(MappedFileTest, ReadChunks)
+{
+    ChunkedFileReader reader{ m_path, 1000 };
+    std::string contents;
+    size_t chunks{ 0 };
+    while(!reader.isEndOfFile())
+    {
+        std::span<const std::byte> chunk{ reader.read() };
+        ASSERT_LE(chunk.size(), 1000);
+        contents.append(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+        chunks++;
+    }
+    ASSERT_EQ(contents, m_contents);
+    ASSERT_EQ(chunks, m_contents.size() / 1000 + 1);
+    ASSERT_TRUE(reader.read().empty());
+}
+
+TEST_F(MappedFileTest, ReadFileBytes)
+{
+    std::vector<std::byte> bytes{ CodeHelpers::readFileBytes(m_path) };
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()), m_contents);
+    ASSERT_TRUE(CodeHelpers::readFileBytes(m_emptyPath).empty());
+    ASSERT_TRUE(CodeHelpers::readFileBytes("mapped_missing.txt").empty());
+}
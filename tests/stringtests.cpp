@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
 #include "helpers/codehelpers.h"
+#include "helpers/stringbuilder.h"
 #include "helpers/stringhelpers.h"
 #include "network/web.h"
 
@@ -26,6 +29,20 @@ TEST(StringTests, Lower2)
     ASSERT_EQ(StringHelpers::lower("uy7tG8"), "uy7tg8");
 }
 
+TEST(StringTests, Upper3)
+{
+    std::string s{ "The quick brown fox jumps over the lazy dog @[`{ \xc3\xa9" };
+    StringHelpers::upperInPlace(s);
+    ASSERT_EQ(s, "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG @[`{ \xc3\xa9");
+}
+
+TEST(StringTests, Lower3)
+{
+    std::string s{ "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG @[`{ \xc3\x89" };
+    StringHelpers::lowerInPlace(s);
+    ASSERT_EQ(s, "the quick brown fox jumps over the lazy dog @[`{ \xc3\x89");
+}
+
 TEST(StringTests, Trim1)
 {
     ASSERT_EQ(StringHelpers::trim("     abc        "), "abc");
@@ -41,6 +58,25 @@ TEST(StringTests, Trim3)
     ASSERT_EQ(StringHelpers::trim("---abc-rf---", '-'), "abc-rf");
 }
 
+TEST(StringTests, Trim4)
+{
+    ASSERT_EQ(StringHelpers::trimView(" \t\r\nabc f\n "), "abc f");
+    ASSERT_EQ(StringHelpers::trimView("    "), "");
+    ASSERT_EQ(StringHelpers::trimView("---", '-'), "");
+    ASSERT_EQ(StringHelpers::trimView("\"quoted\"", '"'), "quoted");
+}
+
+TEST(StringTests, IgnoreCase1)
+{
+    ASSERT_EQ(StringHelpers::compareIgnoreCase("Setup.EXE", "setup.exe"), 0);
+    ASSERT_LT(StringHelpers::compareIgnoreCase("abc", "ABD"), 0);
+    ASSERT_GT(StringHelpers::compareIgnoreCase("abcd", "ABC"), 0);
+    ASSERT_EQ(StringHelpers::findIgnoreCase("App_Linux_x86_64.AppImage", "x86_64.appimage"), 10);
+    ASSERT_EQ(StringHelpers::findIgnoreCase("App_Linux", "linux", 5), std::string::npos);
+    ASSERT_EQ(StringHelpers::findIgnoreCase("abc", ""), 0);
+    ASSERT_EQ(StringHelpers::findIgnoreCase("abc", "abcd"), std::string::npos);
+}
+
 TEST(StringTests, Split1)
 {
     std::vector<std::string> cmd{ StringHelpers::split("libnick -t fg -y", " ")};
@@ -80,6 +116,40 @@ TEST(StringTests, Split4)
     ASSERT_EQ(cmd[3], "-y");
 }
 
+TEST(StringTests, Split5)
+{
+    std::vector<std::string_view> tokens;
+    for(std::string_view token : StringHelpers::SplitView{ "a,,b, ,c", ',', false })
+    {
+        tokens.push_back(token);
+    }
+    ASSERT_EQ(tokens.size(), 3);
+    ASSERT_EQ(tokens[0], "a");
+    ASSERT_EQ(tokens[1], "b");
+    ASSERT_EQ(tokens[2], "c");
+}
+
+TEST(StringTests, Split6)
+{
+    std::vector<std::string> cmd{ StringHelpers::split("a::b::::c::", "::") };
+    ASSERT_EQ(cmd.size(), 5);
+    ASSERT_EQ(cmd[0], "a");
+    ASSERT_EQ(cmd[1], "b");
+    ASSERT_EQ(cmd[2], "");
+    ASSERT_EQ(cmd[3], "c");
+    ASSERT_EQ(cmd[4], "");
+    ASSERT_EQ(StringHelpers::split("abc", "").size(), 1);
+}
+
+TEST(StringTests, Split7)
+{
+    std::vector<std::string> cmd{ StringHelpers::splitArgs("  echo a\"b c\"d 'e  ")};
+    ASSERT_EQ(cmd.size(), 3);
+    ASSERT_EQ(cmd[0], "echo");
+    ASSERT_EQ(cmd[1], "a\"b c\"d");
+    ASSERT_EQ(cmd[2], "e");
+}
+
 TEST(StringTests, Uuid1)
 {
     std::string s;
@@ -118,6 +188,14 @@ TEST(StringTests, UrlValidity6)
     ASSERT_TRUE(StringHelpers::isValidUrl("https://www.youtube.com/watch?v=UKwSQSFN4Nw&list=PLXJg25X-OulsVsnvZ7RVtSDW-id9_RzAO"));
 }
 
+TEST(StringTests, UrlValidity7)
+{
+    ASSERT_TRUE(StringHelpers::isValidUrl("http://www.example-site.co.uk:8080/path?q=1"));
+    ASSERT_FALSE(StringHelpers::isValidUrl("https://example..com"));
+    ASSERT_FALSE(StringHelpers::isValidUrl("https://example.com:123456"));
+    ASSERT_FALSE(StringHelpers::isValidUrl("https://example.c0m"));
+}
+
 TEST(StringTests, Join1)
 {
     ASSERT_EQ(StringHelpers::join({ "hi", "bye" }, "|"), "hi|bye");
@@ -133,6 +211,24 @@ TEST(StringTests, Join3)
     ASSERT_EQ(StringHelpers::join({ "hi" }, "\n"), "hi");
 }
 
+TEST(StringTests, Join4)
+{
+    ASSERT_EQ(StringHelpers::join({}, "|", true), "");
+    ASSERT_EQ(StringHelpers::join({ "", "a", "" }, ", "), ", a, ");
+}
+
+TEST(StringTests, Builder1)
+{
+    StringBuilder builder{ 64 };
+    ASSERT_TRUE(builder.empty());
+    ASSERT_GE(builder.capacity(), 64);
+    builder.append("Hello").append(' ').appendLine("World").appendFormat("{}-{}", 1, "two");
+    ASSERT_EQ(builder.view(), "Hello World\n1-two");
+    ASSERT_EQ(builder.str(), "Hello World\n1-two");
+    ASSERT_EQ(builder.release(), "Hello World\n1-two");
+    ASSERT_TRUE(builder.empty());
+}
+
 TEST(StringTests, Replace1)
 {
     ASSERT_EQ(StringHelpers::replace("hello bye hi", "bye", "goodbye"), "hello goodbye hi");
@@ -210,6 +306,26 @@ TEST(StringTests, Base643)
     std::filesystem::remove("img.png");
 }
 
+TEST(StringTests, Base644)
+{
+    std::vector<std::byte> s{ std::byte{'l'}, std::byte{'i'}, std::byte{'b'}, std::byte{'n'} };
+    std::array<char, 8> base64;
+    ASSERT_EQ(StringHelpers::encodedSize(s.size()), base64.size());
+    ASSERT_EQ(StringHelpers::encode(s, base64), base64.size());
+    ASSERT_EQ(std::string_view(base64.data(), base64.size()), "bGlibg==");
+    std::array<std::byte, 4> bytes;
+    ASSERT_EQ(StringHelpers::decodedSize("bGlibg=="), bytes.size());
+    ASSERT_EQ(StringHelpers::decode("bGlibg==", bytes), bytes.size());
+    ASSERT_TRUE(std::equal(bytes.begin(), bytes.end(), s.begin()));
+}
+
+TEST(StringTests, Base645)
+{
+    ASSERT_TRUE(StringHelpers::decode("bGl*bg==").empty());
+    ASSERT_TRUE(StringHelpers::decode("bGlib").empty());
+    ASSERT_TRUE(StringHelpers::decode("====").empty());
+}
+
 TEST(StringTests, SToW1)
 {
     ASSERT_EQ(StringHelpers::wstr("hello"), L"hello");
@@ -229,3 +345,18 @@ TEST(StringTests, WToS2)
 {
     ASSERT_EQ(StringHelpers::str(L"goodbye my friend"), "goodbye my friend");
 }
+
+TEST(StringTests, SToW3)
+{
+    ASSERT_EQ(StringHelpers::wstr("h\xc3\xa9llo \xe2\x82\xac \xf0\x9f\x98\x80"), L"h\u00e9llo \u20ac \U0001F600");
+    ASSERT_TRUE(StringHelpers::wstr("bad \xc3\x28").empty());
+    ASSERT_TRUE(StringHelpers::wstr("overlong \xc0\xaf").empty());
+}
+
+TEST(StringTests, WToS3)
+{
+    ASSERT_EQ(StringHelpers::str(L"h\u00e9llo \u20ac \U0001F600"), "h\xc3\xa9llo \xe2\x82\xac \xf0\x9f\x98\x80");
+    std::array<char, 4> buffer;
+    ASSERT_EQ(StringHelpers::str(L"\U0001F600", buffer), 4);
+    ASSERT_EQ(StringHelpers::str(L"abcde", buffer), 0);
+}